@@ -0,0 +1,119 @@
+#include "include/Attacks.h"
+
+namespace Attacks {
+
+    Magic RookMagics[64];
+    Magic BishopMagics[64];
+
+    namespace {
+
+        Bitboard RookTable[0x19000];
+        Bitboard BishopTable[0x1480];
+
+        constexpr int RookDirections[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+        constexpr int BishopDirections[4][2] = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+
+        Bitboard slidingAttacks(int square, Bitboard occupied, const int (&directions)[4][2]) {
+            Bitboard attacks = 0;
+            for (const auto &direction : directions) {
+                int row = rowOf(square) + direction[0];
+                int col = colOf(square) + direction[1];
+                while (row >= 0 && row < 8 && col >= 0 && col < 8) {
+                    Bitboard bb = squareBB(squareOf(row, col));
+                    attacks |= bb;
+                    if (occupied & bb) break;
+                    row += direction[0];
+                    col += direction[1];
+                }
+            }
+            return attacks;
+        }
+
+        // Relevant occupancy: the rays without the board edge they run into.
+        Bitboard relevantMask(int square, const int (&directions)[4][2]) {
+            Bitboard mask = 0;
+            for (const auto &direction : directions) {
+                int row = rowOf(square) + direction[0];
+                int col = colOf(square) + direction[1];
+                while (row + direction[0] >= 0 && row + direction[0] < 8 && col + direction[1] >= 0 && col + direction[1] < 8) {
+                    mask |= squareBB(squareOf(row, col));
+                    row += direction[0];
+                    col += direction[1];
+                }
+            }
+            return mask;
+        }
+
+        struct Random {
+            uint64_t state;
+
+            uint64_t next() {
+                state ^= state >> 12;
+                state ^= state << 25;
+                state ^= state >> 27;
+                return state * 2685821657736338717ULL;
+            }
+
+            uint64_t sparse() {
+                return next() & next() & next();
+            }
+        };
+
+        void buildTable(Magic (&magics)[64], Bitboard *table, const int (&directions)[4][2]) {
+            Bitboard occupancy[4096];
+            Bitboard reference[4096];
+            int epoch[4096] = {};
+            int attempt = 0;
+            Random random{0x9E3779B97F4A7C15ULL};
+
+            for (int square = 0; square < 64; ++square) {
+                Magic &m = magics[square];
+                m.mask = relevantMask(square, directions);
+                m.shift = 64 - popCount(m.mask);
+                m.attacks = table;
+
+                // Enumerate every subset of the mask (Carry-Rippler).
+                int size = 0;
+                Bitboard subset = 0;
+                do {
+                    occupancy[size] = subset;
+                    reference[size] = slidingAttacks(square, subset, directions);
+                    if (UsePext) m.attacks[m.index(subset)] = reference[size];
+                    size++;
+                    subset = (subset - m.mask) & m.mask;
+                } while (subset);
+                table += size;
+
+                if (UsePext) continue;
+
+                for (int i = 0; i < size;) {
+                    do {
+                        m.magic = random.sparse();
+                    } while (popCount((m.magic * m.mask) >> 56) < 6);
+
+                    ++attempt;
+                    for (i = 0; i < size; ++i) {
+                        unsigned index = m.index(occupancy[i]);
+                        if (epoch[index] < attempt) {
+                            epoch[index] = attempt;
+                            m.attacks[index] = reference[i];
+                        } else if (m.attacks[index] != reference[i]) {
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        bool build() {
+            buildTable(RookMagics, RookTable, RookDirections);
+            buildTable(BishopMagics, BishopTable, BishopDirections);
+            return true;
+        }
+    }
+
+    void init() {
+        static const bool initialized = build();
+        (void) initialized;
+    }
+}
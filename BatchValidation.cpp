@@ -0,0 +1,90 @@
+#include <algorithm>
+#include <cstring>
+#include "include/Attacks.h"
+#include "include/BatchValidation.h"
+
+namespace {
+    // Squares a piece could reach on an empty board, castling and double pushes included: every
+    // legal move is inside it, and most random or stale requests are not.
+    constexpr std::array<std::array<Bitboard, 64>, PieceCount> Reach = [] {
+        std::array<std::array<Bitboard, 64>, PieceCount> reach{};
+        auto ray = [](int square, int rowStep, int colStep) {
+            Bitboard squares = 0;
+            for (int row = rowOf(square) + rowStep, col = colOf(square) + colStep;
+                 row >= 0 && row < 8 && col >= 0 && col < 8; row += rowStep, col += colStep) {
+                squares |= squareBB(squareOf(row, col));
+            }
+            return squares;
+        };
+        for (int square = 0; square < 64; ++square) {
+            Bitboard diagonal = ray(square, 1, 1) | ray(square, 1, -1) | ray(square, -1, 1) | ray(square, -1, -1);
+            Bitboard straight = ray(square, 1, 0) | ray(square, -1, 0) | ray(square, 0, 1) | ray(square, 0, -1);
+            for (Color color : {White, Black}) {
+                int forward = color == White ? 8 : -8;
+                Bitboard pawn = Attacks::PawnAttacks[color][square];
+                if (square + forward >= 0 && square + forward < 64) pawn |= squareBB(square + forward);
+                if (rowOf(square) == (color == White ? 1 : 6)) pawn |= squareBB(square + 2 * forward);
+
+                Bitboard king = Attacks::KingAttacks[square];
+                if (square == squareOf(color == White ? 0 : 7, 4)) king |= squareBB(square - 2) | squareBB(square + 2);
+
+                reach[makePiece(color, Pawn)][square] = pawn;
+                reach[makePiece(color, Knight)][square] = Attacks::KnightAttacks[square];
+                reach[makePiece(color, Bishop)][square] = diagonal;
+                reach[makePiece(color, Rook)][square] = straight;
+                reach[makePiece(color, Queen)][square] = diagonal | straight;
+                reach[makePiece(color, King)][square] = king;
+            }
+        }
+        return reach;
+    }();
+
+    constexpr unsigned nibble(const CompactPosition &position, int square) {
+        return (position.squares[square >> 1] >> ((square & 1) * 4)) & 15;
+    }
+}
+
+bool validateMoves(std::span<const CompactPosition> positions, std::span<const Move> moves, std::span<uint64_t> legal) {
+    bool shared = positions.size() == 1;
+    if ((!shared && positions.size() != moves.size()) || legal.size() < (moves.size() + 63) / 64) return false;
+
+    // Pass 1, branch-free: piece belongs to the side to move, the target is not its own piece and
+    // lies on the piece's empty-board reach. Each word is built from 64 independent lanes.
+    for (size_t word = 0; word * 64 < moves.size(); ++word) {
+        size_t count = std::min<size_t>(64, moves.size() - word * 64);
+        uint64_t bits = 0;
+        for (size_t lane = 0; lane < count; ++lane) {
+            size_t i = word * 64 + lane;
+            const CompactPosition &position = positions[shared ? 0 : i];
+            int from = moves[i].from();
+            int to = moves[i].to();
+            unsigned piece = nibble(position, from);
+            unsigned target = nibble(position, to);
+            bool candidate = piece != NoPiece && (piece >> 3) == position.side
+                             && (target == NoPiece || (target >> 3) != position.side)
+                             && ((Reach[piece][from] >> to) & 1);
+            bits |= static_cast<uint64_t>(candidate) << lane;
+        }
+        legal[word] = bits;
+    }
+
+    // Pass 2: full rules for the survivors on a stack board, unpacked only when the position changes.
+    Board board;
+    const CompactPosition *unpacked = nullptr;
+    for (size_t word = 0; word < (moves.size() + 63) / 64; ++word) {
+        for (uint64_t bits = legal[word]; bits;) {
+            size_t i = word * 64 + popLsb(bits);
+            const CompactPosition &position = positions[shared ? 0 : i];
+            if (!unpacked || std::memcmp(unpacked, &position, sizeof(CompactPosition)) != 0) {
+                if (!board.fromCompact(position)) {
+                    unpacked = nullptr;
+                    legal[word] &= ~(1ull << (i & 63));
+                    continue;
+                }
+                unpacked = &position;
+            }
+            if (board.resolveMove(moves[i].from(), moves[i].to()) == Move{}) legal[word] &= ~(1ull << (i & 63));
+        }
+    }
+    return true;
+}
@@ -0,0 +1,28 @@
+#include "include/Bitboards.h"
+#include "include/Board.h"
+
+Piece Bitboards::pieceOn(int square) const {
+    Bitboard bb = squareBB(square);
+    if (!(occupied & bb)) return NoPiece;
+    for (int i = 1; i < PieceCount; ++i) {
+        if (pieces[i] & bb) return static_cast<Piece>(i);
+    }
+    return NoPiece;
+}
+
+Bitboards Bitboards::fromBoard(const Board &board) {
+    Bitboards result;
+    for (int square = 0; square < 64; ++square) {
+        Piece piece = board.pieceAt(rowOf(square), colOf(square));
+        if (piece != NoPiece) result.add(piece, square);
+    }
+    return result;
+}
+
+Board Bitboards::toBoard() const {
+    Board board;
+    for (int square = 0; square < 64; ++square) {
+        board.setPiece(rowOf(square), colOf(square), pieceOn(square));
+    }
+    return board;
+}
@@ -1,197 +1,709 @@
-#include <utility>
-#include <iostream>
+#include <cassert>
+#include <cstdlib>
+#include <limits>
+#include "include/Attacks.h"
 #include "include/Board.h"
+#include "include/Instrumentation.h"
+#include "include/Nnue.h"
+#include "include/Tablebase.h"
+#include "include/Zobrist.h"
+
+namespace {
+    // Rights that survive a move touching each square (a king or rook leaving or being captured).
+    constexpr auto CastlingMask = [] {
+        std::array<uint8_t, 64> mask{};
+        mask.fill(AllCastling);
+        mask[squareOf(0, 0)] &= ~WhiteQueenSide;
+        mask[squareOf(0, 7)] &= ~WhiteKingSide;
+        mask[squareOf(0, 4)] &= ~(WhiteKingSide | WhiteQueenSide);
+        mask[squareOf(7, 0)] &= ~BlackQueenSide;
+        mask[squareOf(7, 7)] &= ~BlackKingSide;
+        mask[squareOf(7, 4)] &= ~(BlackKingSide | BlackQueenSide);
+        return mask;
+    }();
+}
 
-Board::Board() : grid(8, std::vector<std::string>(8, "")) {}
+Board::Board() {
+    Attacks::init();
+}
 
 void Board::initialize() {
-    initializeRow(1, "white_pawn");
-    initializeRow(6, "black_pawn");
+    side = White;
+    castling = AllCastling;
+    epSquare = NoSquare;
+    halfmoves = 0;
+    fullmoves = 1;
+
+    initializeRow(1, WhitePawn);
+    initializeRow(6, BlackPawn);
 
-    initializePiece(0, 0, "white_rook");
-    initializePiece(0, 7, "white_rook");
-    initializePiece(7, 0, "black_rook");
-    initializePiece(7, 7, "black_rook");
+    initializePiece(0, 0, WhiteRook);
+    initializePiece(0, 7, WhiteRook);
+    initializePiece(7, 0, BlackRook);
+    initializePiece(7, 7, BlackRook);
 
-    initializePiece(0, 1, "white_knight");
-    initializePiece(0, 6, "white_knight");
-    initializePiece(7, 1, "black_knight");
-    initializePiece(7, 6, "black_knight");
+    initializePiece(0, 1, WhiteKnight);
+    initializePiece(0, 6, WhiteKnight);
+    initializePiece(7, 1, BlackKnight);
+    initializePiece(7, 6, BlackKnight);
 
-    initializePiece(0, 2, "white_bishop");
-    initializePiece(0, 5, "white_bishop");
-    initializePiece(7, 2, "black_bishop");
-    initializePiece(7, 5, "black_bishop");
+    initializePiece(0, 2, WhiteBishop);
+    initializePiece(0, 5, WhiteBishop);
+    initializePiece(7, 2, BlackBishop);
+    initializePiece(7, 5, BlackBishop);
 
-    initializePiece(0, 3, "white_queen");
-    initializePiece(7, 3, "black_queen");
+    initializePiece(0, 3, WhiteQueen);
+    initializePiece(7, 3, BlackQueen);
 
-    initializePiece(0, 4, "white_king");
-    initializePiece(7, 4, "black_king");
+    initializePiece(0, 4, WhiteKing);
+    initializePiece(7, 4, BlackKing);
+
+    key = computeHash();
 }
 
-void Board::initializeRow(int row, const std::string& piece) {
+void Board::initializeRow(int row, Piece piece) {
     for (int i = 0; i < 8; i++) {
-        grid[row][i] = piece;
+        placePiece(squareOf(row, i), piece);
     }
 }
 
-void Board::initializePiece(int row, int col, const std::string& piece) {
-    grid[row][col] = piece;
+void Board::initializeRow(int row, std::string_view piece) {
+    initializeRow(row, pieceFromName(piece));
 }
 
-int Board::getRows() const {
-    return grid.size();
+void Board::initializePiece(int row, int col, Piece piece) {
+    placePiece(squareOf(row, col), piece);
 }
 
-int Board::getColumns() const {
-    return grid[0].size();
+void Board::initializePiece(int row, int col, std::string_view piece) {
+    initializePiece(row, col, pieceFromName(piece));
 }
 
-std::string Board::getPieceAt(int row, int col) const {
-    return grid[row][col];
-}
+bool Board::fromFEN(std::string_view fen) {
+    Board parsed;
+    size_t pos = 0;
+    auto nextField = [&]() {
+        while (pos < fen.size() && fen[pos] == ' ') ++pos;
+        size_t start = pos;
+        while (pos < fen.size() && fen[pos] != ' ') ++pos;
+        return fen.substr(start, pos - start);
+    };
+    auto parseNumber = [](std::string_view field, uint16_t &value) {
+        if (field.empty()) return true;
+        unsigned number = 0;
+        for (char c : field) {
+            if (c < '0' || c > '9') return false;
+            number = number * 10 + (c - '0');
+            if (number > std::numeric_limits<uint16_t>::max()) return false;
+        }
+        value = static_cast<uint16_t>(number);
+        return true;
+    };
+
+    int row = 7;
+    int col = 0;
+    for (char c : nextField()) {
+        if (c == '/') {
+            if (col != 8 || row == 0) return false;
+            --row;
+            col = 0;
+        } else if (c >= '1' && c <= '8') {
+            col += c - '0';
+            if (col > 8) return false;
+        } else {
+            Piece piece = pieceFromChar(c);
+            if (piece == NoPiece || col > 7) return false;
+            parsed.placePiece(squareOf(row, col++), piece);
+        }
+    }
+    if (row != 0 || col != 8) return false;
+
+    std::string_view side = nextField();
+    if (side != "w" && side != "b") return false;
+    parsed.side = (side == "w") ? White : Black;
+
+    std::string_view rights = nextField();
+    if (rights.empty()) return false;
+    if (rights != "-") {
+        for (char c : rights) {
+            switch (c) {
+                case 'K': parsed.castling |= WhiteKingSide; break;
+                case 'Q': parsed.castling |= WhiteQueenSide; break;
+                case 'k': parsed.castling |= BlackKingSide; break;
+                case 'q': parsed.castling |= BlackQueenSide; break;
+                default: return false;
+            }
+        }
+    }
 
-void Board::setPieceAt(int row, int col, std::string piece) {
-    grid[row][col] = std::move(piece);
-}
+    std::string_view ep = nextField();
+    if (ep.empty()) return false;
+    if (ep != "-") {
+        if (ep.size() != 2 || ep[0] < 'a' || ep[0] > 'h' || (ep[1] != '3' && ep[1] != '6')) return false;
+        parsed.epSquare = static_cast<int8_t>(squareOf(ep[1] - '1', ep[0] - 'a'));
+    }
 
-bool Board::movePiece(int startRow, int startCol, int endRow, int endCol) {
-    std::string piece = getPieceAt(startRow, startCol);
+    if (!parseNumber(nextField(), parsed.halfmoves) || !parseNumber(nextField(), parsed.fullmoves)) return false;
+    if (parsed.fullmoves == 0) parsed.fullmoves = 1;
+    // placePiece already folded in the pieces.
+    parsed.key ^= Zobrist::castling(parsed.castling) ^ Zobrist::enPassant(parsed.epSquare);
+    if (parsed.side == Black) parsed.key ^= Zobrist::sideToMove();
+    assert(parsed.key == parsed.computeHash());
 
-    if (piece == "white_pawn" || piece == "black_pawn") {
-        return movePawn(startRow, startCol, endRow, endCol, piece);
+    *this = parsed;
+    if (link.target) link.target->refresh(*this);
+    return true;
+}
+
+int Board::toFEN(char *out) const {
+    char *p = out;
+    for (int row = 7; row >= 0; --row) {
+        int empty = 0;
+        for (int col = 0; col < 8; ++col) {
+            Piece piece = squares[squareOf(row, col)];
+            if (piece == NoPiece) {
+                ++empty;
+                continue;
+            }
+            if (empty) *p++ = static_cast<char>('0' + empty);
+            empty = 0;
+            *p++ = pieceChar(piece);
+        }
+        if (empty) *p++ = static_cast<char>('0' + empty);
+        if (row) *p++ = '/';
     }
-    if (piece == "white_rook" || piece == "black_rook") {
-        return moveRook(startRow, startCol, endRow, endCol, piece);
+
+    *p++ = ' ';
+    *p++ = side == White ? 'w' : 'b';
+    *p++ = ' ';
+    if (castling == NoCastling) *p++ = '-';
+    if (castling & WhiteKingSide) *p++ = 'K';
+    if (castling & WhiteQueenSide) *p++ = 'Q';
+    if (castling & BlackKingSide) *p++ = 'k';
+    if (castling & BlackQueenSide) *p++ = 'q';
+    *p++ = ' ';
+    if (epSquare == NoSquare) {
+        *p++ = '-';
+    } else {
+        *p++ = static_cast<char>('a' + colOf(epSquare));
+        *p++ = static_cast<char>('1' + rowOf(epSquare));
     }
-    if (piece == "white_bishop" || piece == "black_bishop") {
-        return moveBishop(startRow, startCol, endRow, endCol, piece);
+
+    auto writeNumber = [&p](unsigned number) {
+        char digits[5];
+        int count = 0;
+        do {
+            digits[count++] = static_cast<char>('0' + number % 10);
+            number /= 10;
+        } while (number);
+        while (count) *p++ = digits[--count];
+    };
+    *p++ = ' ';
+    writeNumber(halfmoves);
+    *p++ = ' ';
+    writeNumber(fullmoves);
+    *p = '\0';
+    return static_cast<int>(p - out);
+}
+
+CompactPosition Board::compact() const {
+    CompactPosition position{};
+    for (int square = 0; square < 64; square += 2) {
+        position.squares[square / 2] = static_cast<uint8_t>(squares[square] | (squares[square + 1] << 4));
     }
-    if (piece == "white_knight" || piece == "black_knight") {
-        return moveKnight(startRow, startCol, endRow, endCol, piece);
+    position.side = side;
+    position.castling = castling;
+    position.epSquare = epSquare;
+    return position;
+}
+
+bool Board::fromCompact(const CompactPosition &position) {
+    if (position.side > Black || position.castling > AllCastling) return false;
+    if (position.epSquare != NoSquare && (position.epSquare < 0 || position.epSquare > 63)) return false;
+
+    Board unpacked;
+    for (int square = 0; square < 64; ++square) {
+        auto piece = static_cast<Piece>((position.squares[square / 2] >> (square & 1) * 4) & 15);
+        if (piece != NoPiece && (typeOf(piece) == NoPieceType || typeOf(piece) > King)) return false;
+        if (piece != NoPiece) unpacked.placePiece(square, piece);
     }
-    if (piece == "white_queen" || piece == "black_queen") {
-        return moveQueen(startRow, startCol, endRow, endCol, piece);
+    unpacked.side = static_cast<Color>(position.side);
+    unpacked.castling = position.castling;
+    unpacked.epSquare = position.epSquare;
+    unpacked.key ^= Zobrist::castling(unpacked.castling) ^ Zobrist::enPassant(unpacked.epSquare);
+    if (unpacked.side == Black) unpacked.key ^= Zobrist::sideToMove();
+
+    *this = unpacked;
+    if (link.target) link.target->refresh(*this);
+    return true;
+}
+
+Move Board::resolveMove(int from, int to) const {
+    Piece piece = squares[from];
+    if (piece == NoPiece || colorOf(piece) != side || from == to) return Move{};
+
+    int flag = -1;
+    PieceType type = typeOf(piece);
+    if (type == Pawn) {
+        flag = pawnMoveFlag(from, to, side);
+        if (flag >= 0 && (flag & PromoteKnight)) flag |= PromoteQueen;
+    } else if (type == King) {
+        flag = castleFlag(from, to, side);
     }
-    if (piece == "white_king" || piece == "black_king") {
-        return moveKing(startRow, startCol, endRow, endCol, piece);
+
+    if (flag < 0 && type != Pawn) {
+        Bitboard targets;
+        switch (type) {
+            case Knight: targets = Attacks::knight(from); break;
+            case Bishop: targets = Attacks::bishop(from, bb.occupied); break;
+            case Rook: targets = Attacks::rook(from, bb.occupied); break;
+            case Queen: targets = Attacks::queen(from, bb.occupied); break;
+            default: targets = Attacks::king(from); break;
+        }
+        if (!(targets & squareBB(to) & ~bb.byColor[side])) return Move{};
+        flag = squares[to] != NoPiece ? Capture : Quiet;
     }
-    return false;
+    if (flag < 0) return Move{};
+
+    Move move(from, to, flag);
+    return isLegal(move) ? move : Move{};
 }
 
-bool Board::movePawn(int startRow, int startCol, int endRow, int endCol, const std::string& piece) {
-    int direction = (piece == "white_pawn") ? 1 : -1;
-    std::string opponent = (piece == "white_pawn") ? "black" : "white";
+int Board::getRows() const {
+    return 8;
+}
 
-    if (startRow + direction == endRow && startCol == endCol && grid[endRow][endCol].empty()) {
-        grid[endRow][endCol] = piece;
-        grid[startRow][startCol] = "";
-        return true;
+int Board::getColumns() const {
+    return 8;
+}
+
+std::string Board::getPieceAt(int row, int col) const {
+    return std::string(pieceName(squares[squareOf(row, col)]));
+}
+
+void Board::setPieceAt(int row, int col, std::string_view piece) {
+    placePiece(squareOf(row, col), pieceFromName(piece));
+}
+
+Piece Board::pieceAt(int row, int col) const {
+    return squares[squareOf(row, col)];
+}
+
+void Board::setPiece(int row, int col, Piece piece) {
+    placePiece(squareOf(row, col), piece);
+}
+
+const Bitboards &Board::bitboards() const {
+    return bb;
+}
+
+const std::array<Piece, 64> &Board::mailbox() const {
+    return squares;
+}
+
+void Board::attachAccumulator(Nnue::Accumulator *accumulator) {
+    link.target = accumulator;
+    if (accumulator) accumulator->refresh(*this);
+}
+
+const Nnue::Accumulator *Board::accumulator() const {
+    return link.target;
+}
+
+bool Board::probeTablebase(const Tablebases &tables, TablebaseResult &result) const {
+    return tables.probe(*this, result);
+}
+
+Color Board::sideToMove() const {
+    return side;
+}
+
+void Board::setSideToMove(Color color) {
+    if (color != side) key ^= Zobrist::sideToMove();
+    side = color;
+}
+
+uint8_t Board::castlingRights() const {
+    return castling;
+}
+
+int Board::enPassantSquare() const {
+    return epSquare;
+}
+
+int Board::halfmoveClock() const {
+    return halfmoves;
+}
+
+int Board::fullmoveNumber() const {
+    return fullmoves;
+}
+
+void Board::placePiece(int square, Piece piece) {
+    if (link.target) {
+        if (squares[square] != NoPiece) link.target->remove(squares[square], square);
+        if (piece != NoPiece) link.target->add(piece, square);
     }
-    if (startRow + 2 * direction == endRow && startCol == endCol && grid[startRow + direction][endCol].empty() && grid[endRow][endCol].empty()) {
-        grid[endRow][endCol] = piece;
-        grid[startRow][startCol] = "";
-        return true;
+    if (squares[square] != NoPiece) bb.remove(squares[square], square);
+    key ^= Zobrist::piece(squares[square], square) ^ Zobrist::piece(piece, square);
+    if (typeOf(squares[square]) == Pawn) pawnKey ^= Zobrist::piece(squares[square], square);
+    if (typeOf(piece) == Pawn) pawnKey ^= Zobrist::piece(piece, square);
+    squares[square] = piece;
+    if (piece != NoPiece) bb.add(piece, square);
+}
+
+uint64_t Board::hash() const {
+    return key;
+}
+
+uint64_t Board::pawnHash() const {
+    return pawnKey;
+}
+
+uint64_t Board::computePawnHash() const {
+    uint64_t hash = 0;
+    for (int square = 0; square < 64; ++square) {
+        if (typeOf(squares[square]) == Pawn) hash ^= Zobrist::piece(squares[square], square);
     }
-    if (startRow + direction == endRow && (endCol == startCol + 1 || endCol == startCol - 1) && grid[endRow][endCol].find(opponent) != std::string::npos) {
-        grid[endRow][endCol] = piece;
-        grid[startRow][startCol] = "";
-        return true;
+    return hash;
+}
+
+uint64_t Board::computeHash() const {
+    uint64_t hash = Zobrist::castling(castling) ^ Zobrist::enPassant(epSquare);
+    if (side == Black) hash ^= Zobrist::sideToMove();
+    for (int square = 0; square < 64; ++square) {
+        hash ^= Zobrist::piece(squares[square], square);
     }
-    if (startRow + direction == endRow && (endCol == startCol + 1 || endCol == startCol - 1) && grid[startRow][endCol] == opponent + "_pawn" && grid[endRow][endCol].empty()) {
-        grid[endRow][endCol] = piece;
-        grid[startRow][startCol] = "";
-        grid[startRow][endCol] = "";
-        return true;
+    return hash;
+}
+
+bool Board::movePiece(int startRow, int startCol, int endRow, int endCol) {
+    Piece piece = pieceAt(startRow, startCol);
+
+    switch (typeOf(piece)) {
+        case Pawn:
+            return movePawn(startRow, startCol, endRow, endCol, piece);
+        case Rook:
+            return moveRook(startRow, startCol, endRow, endCol, piece);
+        case Bishop:
+            return moveBishop(startRow, startCol, endRow, endCol, piece);
+        case Knight:
+            return moveKnight(startRow, startCol, endRow, endCol, piece);
+        case Queen:
+            return moveQueen(startRow, startCol, endRow, endCol, piece);
+        case King:
+            return moveKing(startRow, startCol, endRow, endCol, piece);
+        default:
+            return false;
     }
-    if (startRow == (piece == "white_pawn" ? 6 : 1) && endRow == (piece == "white_pawn" ? 7 : 0) && startCol == endCol) {
-        grid[endRow][endCol] = (piece == "white_pawn") ? "white_queen" : "black_queen";
-        grid[startRow][startCol] = "";
-        return true;
+}
+
+bool Board::movePawn(int startRow, int startCol, int endRow, int endCol, Piece piece) {
+    Instrumentation::CallScope call(Instrumentation::MovePawn);
+    int start = squareOf(startRow, startCol);
+    int end = squareOf(endRow, endCol);
+    int flag = pawnMoveFlag(start, end, colorOf(piece));
+    if (flag < 0) return call.result(false);
+    if (flag & PromoteKnight) flag |= PromoteQueen; // movePiece always promotes to a queen
+
+    return call.result(playIfLegal(Move(start, end, flag)));
+}
+
+bool Board::moveRook(int startRow, int startCol, int endRow, int endCol, Piece piece) {
+    Instrumentation::CallScope call(Instrumentation::MoveRook);
+    if (!isRookMoveValid(startRow, startCol, endRow, endCol)) return call.result(false);
+    return call.result(moveToTarget(startRow, startCol, endRow, endCol, piece));
+}
+
+bool Board::moveBishop(int startRow, int startCol, int endRow, int endCol, Piece piece) {
+    Instrumentation::CallScope call(Instrumentation::MoveBishop);
+    if (!isBishopMoveValid(startRow, startCol, endRow, endCol)) return call.result(false);
+    return call.result(moveToTarget(startRow, startCol, endRow, endCol, piece));
+}
+
+bool Board::moveKnight(int startRow, int startCol, int endRow, int endCol, Piece piece) {
+    Instrumentation::CallScope call(Instrumentation::MoveKnight);
+    if (!isKnightMoveValid(startRow, startCol, endRow, endCol)) return call.result(false);
+    return call.result(moveToTarget(startRow, startCol, endRow, endCol, piece));
+}
+
+bool Board::moveQueen(int startRow, int startCol, int endRow, int endCol, Piece piece) {
+    Instrumentation::CallScope call(Instrumentation::MoveQueen);
+    if (!isQueenMoveValid(startRow, startCol, endRow, endCol)) return call.result(false);
+    return call.result(moveToTarget(startRow, startCol, endRow, endCol, piece));
+}
+
+bool Board::moveKing(int startRow, int startCol, int endRow, int endCol, Piece piece) {
+    Instrumentation::CallScope call(Instrumentation::MoveKing);
+    int start = squareOf(startRow, startCol);
+    int end = squareOf(endRow, endCol);
+
+    if (isKingMoveValid(startRow, startCol, endRow, endCol)) {
+        // The king itself no longer blocks sliders once it steps away.
+        Bitboard occupied = bb.occupied ^ squareBB(start);
+        if (attackersTo(end, opposite(colorOf(piece)), occupied) & ~squareBB(end)) return call.result(false);
+        return call.result(moveToTarget(startRow, startCol, endRow, endCol, piece));
     }
 
-    return false;
+    int flag = castleFlag(start, end, colorOf(piece));
+    if (flag < 0) return call.result(false);
+    return call.result(playIfLegal(Move(start, end, flag)));
 }
 
-bool Board::moveRook(int startRow, int startCol, int endRow, int endCol, const std::string& piece) {
-    if (!isRookMoveValid(startRow, startCol, endRow, endCol)) return false;
-    std::string targetPiece = getPieceAt(endRow, endCol);
-    if (!targetPiece.empty() && targetPiece.substr(0, 5) == piece.substr(0, 5)) return false; // Prevent capturing own piece
+bool Board::moveToTarget(int startRow, int startCol, int endRow, int endCol, Piece piece) {
+    Piece target = pieceAt(endRow, endCol);
+    if (target != NoPiece && colorOf(target) == colorOf(piece)) return false; // Prevent capturing own piece
 
-    grid[endRow][endCol] = piece;
-    grid[startRow][startCol] = "";
-    return true;
+    return playIfLegal(Move(squareOf(startRow, startCol), squareOf(endRow, endCol), target != NoPiece ? Capture : Quiet));
 }
 
-bool Board::moveBishop(int startRow, int startCol, int endRow, int endCol, const std::string& piece) {
-    if (!isBishopMoveValid(startRow, startCol, endRow, endCol)) return false;
-    std::string targetPiece = getPieceAt(endRow, endCol);
-    if (!targetPiece.empty() && targetPiece.substr(0, 5) == piece.substr(0, 5)) return false; // Prevent capturing own piece
+bool Board::playIfLegal(Move move) {
+    if (!isLegal(move)) return false; // Prevent leaving own king in check
 
-    grid[endRow][endCol] = piece;
-    grid[startRow][startCol] = "";
+    setSideToMove(colorOf(squares[move.from()])); // movePiece does not enforce turn order
+    makeMove(move);
     return true;
 }
 
-bool Board::moveKnight(int startRow, int startCol, int endRow, int endCol, const std::string& piece) {
-    if (!isKnightMoveValid(startRow, startCol, endRow, endCol)) return false;
-    std::string targetPiece = getPieceAt(endRow, endCol);
-    if (!targetPiece.empty() && targetPiece.substr(0, 5) == piece.substr(0, 5)) return false; // Prevent capturing own piece
+// Classifies a pawn move as a MoveFlag (promotion bit set on the last rank), or -1 if the pawn rules forbid it.
+int Board::pawnMoveFlag(int from, int to, Color color) const {
+    int direction = (color == White) ? 1 : -1;
+    int startRow = rowOf(from);
+    int startCol = colOf(from);
+    int endRow = rowOf(to);
+    int endCol = colOf(to);
+    Piece target = squares[to];
+    int flag;
+
+    if (startRow + direction == endRow && startCol == endCol && target == NoPiece) {
+        flag = Quiet;
+    } else if (startRow == (color == White ? 1 : 6) && startRow + 2 * direction == endRow && startCol == endCol && pieceAt(startRow + direction, endCol) == NoPiece && target == NoPiece) {
+        flag = DoublePush;
+    } else if (startRow + direction == endRow && abs(endCol - startCol) == 1 && target != NoPiece && colorOf(target) != color) {
+        flag = Capture;
+    } else if (startRow + direction == endRow && abs(endCol - startCol) == 1 && to == epSquare && pieceAt(startRow, endCol) == makePiece(opposite(color), Pawn)) {
+        flag = EnPassant;
+    } else {
+        return -1;
+    }
 
-    grid[endRow][endCol] = piece;
-    grid[startRow][startCol] = "";
-    return true;
+    if (endRow == (color == White ? 7 : 0)) flag |= PromoteKnight;
+    return flag;
 }
 
-bool Board::moveQueen(int startRow, int startCol, int endRow, int endCol, const std::string& piece) {
-    if (!isQueenMoveValid(startRow, startCol, endRow, endCol)) return false;
-    std::string targetPiece = getPieceAt(endRow, endCol);
-    if (!targetPiece.empty() && targetPiece.substr(0, 5) == piece.substr(0, 5)) return false; // Prevent capturing own piece
+// Returns KingCastle/QueenCastle if the king on `from` may castle to `to`, or -1.
+int Board::castleFlag(int from, int to, Color color) const {
+    int row = (color == White) ? 0 : 7;
+    if (from != squareOf(row, 4) || rowOf(to) != row) return -1;
+    bool kingSide = colOf(to) == 6;
+    if (!kingSide && colOf(to) != 2) return -1;
+
+    uint8_t right = kingSide ? (color == White ? WhiteKingSide : BlackKingSide)
+                             : (color == White ? WhiteQueenSide : BlackQueenSide);
+    int rookSquare = squareOf(row, kingSide ? 7 : 0);
+    if (!(castling & right) || squares[rookSquare] != makePiece(color, Rook)) return -1;
+    if (BetweenBB[from][rookSquare] & bb.occupied) return -1;
+
+    Color them = opposite(color);
+    int step = kingSide ? 1 : -1;
+    if (isSquareAttacked(from, them) || isSquareAttacked(from + step, them) || isSquareAttacked(to, them)) return -1;
+    return kingSide ? KingCastle : QueenCastle;
+}
 
-    grid[endRow][endCol] = piece;
-    grid[startRow][startCol] = "";
-    return true;
+Undo Board::makeMove(Move move) {
+    int from = move.from();
+    int to = move.to();
+    int flag = move.flag();
+    Piece piece = squares[from];
+    Color us = colorOf(piece);
+    Undo undo{squares[to], castling, epSquare, halfmoves, fullmoves, key};
+    bool resetsClock = typeOf(piece) == Pawn || undo.captured != NoPiece;
+
+    if (flag == EnPassant) {
+        int captureSquare = squareOf(rowOf(from), colOf(to));
+        undo.captured = squares[captureSquare];
+        placePiece(captureSquare, NoPiece);
+    }
+    if (move.isPromotion()) piece = makePiece(us, move.promotionType());
+    placePiece(to, piece);
+    placePiece(from, NoPiece);
+
+    if (flag == KingCastle) {
+        placePiece(from + 1, squares[from + 3]);
+        placePiece(from + 3, NoPiece);
+    } else if (flag == QueenCastle) {
+        placePiece(from - 1, squares[from - 4]);
+        placePiece(from - 4, NoPiece);
+    }
+
+    key ^= Zobrist::castling(castling) ^ Zobrist::enPassant(epSquare);
+    castling &= CastlingMask[from] & CastlingMask[to];
+    epSquare = static_cast<int8_t>(flag == DoublePush ? (from + to) / 2 : NoSquare);
+    key ^= Zobrist::castling(castling) ^ Zobrist::enPassant(epSquare) ^ Zobrist::sideToMove();
+    // Both counters stop at the largest value a FEN can hold rather than wrap.
+    constexpr uint16_t CounterLimit = std::numeric_limits<uint16_t>::max();
+    halfmoves = resetsClock ? 0 : static_cast<uint16_t>(halfmoves + (halfmoves < CounterLimit));
+    if (us == Black && fullmoves < CounterLimit) ++fullmoves;
+    side = opposite(us);
+
+    assert(key == computeHash() && pawnKey == computePawnHash());
+    return undo;
 }
 
-bool Board::moveKing(int startRow, int startCol, int endRow, int endCol, const std::string& piece) {
-    if (!isKingMoveValid(startRow, startCol, endRow, endCol)) return false;
-    std::string targetPiece = getPieceAt(endRow, endCol);
-    if (!targetPiece.empty() && targetPiece.substr(0, 5) == piece.substr(0, 5)) return false; // Prevent capturing own piece
+void Board::unmakeMove(Move move, const Undo &undo) {
+    int from = move.from();
+    int to = move.to();
+    int flag = move.flag();
+    Piece piece = squares[to];
+    Color us = colorOf(piece);
+
+    if (move.isPromotion()) piece = makePiece(us, Pawn);
+    placePiece(from, piece);
+    if (flag == EnPassant) {
+        placePiece(to, NoPiece);
+        placePiece(squareOf(rowOf(from), colOf(to)), undo.captured);
+    } else {
+        placePiece(to, undo.captured);
+    }
+
+    if (flag == KingCastle) {
+        placePiece(from + 3, squares[from + 1]);
+        placePiece(from + 1, NoPiece);
+    } else if (flag == QueenCastle) {
+        placePiece(from - 4, squares[from - 1]);
+        placePiece(from - 1, NoPiece);
+    }
+
+    castling = undo.castling;
+    epSquare = undo.epSquare;
+    halfmoves = undo.halfmoveClock;
+    fullmoves = undo.fullmoveNumber;
+    key = undo.hash;
+    side = us;
+
+    assert(key == computeHash() && pawnKey == computePawnHash());
+}
+
+Bitboard Board::attackersTo(int square, Color by, Bitboard occupied) const {
+    Bitboard diagonal = bb.of(by, Bishop) | bb.of(by, Queen);
+    Bitboard straight = bb.of(by, Rook) | bb.of(by, Queen);
+    return (Attacks::pawn(opposite(by), square) & bb.of(by, Pawn))
+           | (Attacks::knight(square) & bb.of(by, Knight))
+           | (Attacks::king(square) & bb.of(by, King))
+           | (Attacks::bishop(square, occupied) & diagonal)
+           | (Attacks::rook(square, occupied) & straight);
+}
+
+bool Board::isSquareAttacked(int square, Color by) const {
+    return attackersTo(square, by, bb.occupied) != 0;
+}
+
+bool Board::isKingInCheck(Color color) const {
+    Bitboard kings = bb.of(color, King);
+    while (kings) {
+        if (isSquareAttacked(popLsb(kings), opposite(color))) return true;
+    }
+    return false;
+}
+
+bool Board::isKingInCheck(const std::string &king) const {
+    return isKingInCheck(king.starts_with("black") ? Black : White);
+}
+
+// True if playing the (pseudo-legal) move leaves none of the mover's kings attacked.
+bool Board::isLegal(Move move) const {
+    int from = move.from();
+    int to = move.to();
+    Piece piece = squares[from];
+    Color us = colorOf(piece);
+    Bitboard kings = bb.of(us, King);
+    if (!kings || move.isCastle()) return true; // castleFlag already checked every square the king crosses
+
+    Bitboard removed = squareBB(to);
+    Bitboard occupied = (bb.occupied ^ squareBB(from)) | squareBB(to);
+    if (move.flag() == EnPassant) {
+        removed = squareBB(squareOf(rowOf(from), colOf(to)));
+        occupied ^= removed;
+    }
+    if (typeOf(piece) == King) kings ^= squareBB(from) | squareBB(to);
 
-    grid[endRow][endCol] = piece;
-    grid[startRow][startCol] = "";
+    while (kings) {
+        if (attackersTo(popLsb(kings), opposite(us), occupied) & ~removed) return false;
+    }
     return true;
 }
 
-bool Board::isRookMoveValid(int startRow, int startCol, int endRow, int endCol) const {
-    if (startRow == endRow) {
-        int minCol = std::min(startCol, endCol);
-        int maxCol = std::max(startCol, endCol);
-        for (int col = minCol + 1; col < maxCol; ++col) {
-            if (!grid[startRow][col].empty()) return false;
+void Board::addPawnMoves(MoveList &moves, int from, int to, int flag) const {
+    if (!(flag & PromoteKnight)) {
+        moves.push(Move(from, to, flag));
+        return;
+    }
+    for (int promotion = PromoteKnight; promotion <= PromoteQueen; ++promotion) {
+        moves.push(Move(from, to, promotion | (flag & Capture)));
+    }
+}
+
+void Board::generateLegalMoves(MoveList &moves) const {
+    moves.clear();
+    Color us = side;
+    Bitboard own = bb.byColor[us];
+    Bitboard enemy = bb.byColor[opposite(us)];
+    int forward = (us == White) ? 8 : -8;
+
+    Bitboard pawns = bb.of(us, Pawn);
+    while (pawns) {
+        int from = popLsb(pawns);
+        if (from + forward < 0 || from + forward >= 64) continue;
+        Bitboard candidates = pawnAttacks(us, squareBB(from)) | squareBB(from + forward);
+        if (from + 2 * forward >= 0 && from + 2 * forward < 64) candidates |= squareBB(from + 2 * forward);
+        while (candidates) {
+            int to = popLsb(candidates);
+            int flag = pawnMoveFlag(from, to, us);
+            if (flag >= 0) addPawnMoves(moves, from, to, flag);
         }
-        return true;
     }
-    if (startCol == endCol) {
-        int minRow = std::min(startRow, endRow);
-        int maxRow = std::max(startRow, endRow);
-        for (int row = minRow + 1; row < maxRow; ++row) {
-            if (!grid[row][startCol].empty()) return false;
+
+    for (PieceType type : {Knight, Bishop, Rook, Queen, King}) {
+        Bitboard pieces = bb.of(us, type);
+        while (pieces) {
+            int from = popLsb(pieces);
+            Bitboard targets;
+            switch (type) {
+                case Knight: targets = Attacks::knight(from); break;
+                case Bishop: targets = Attacks::bishop(from, bb.occupied); break;
+                case Rook: targets = Attacks::rook(from, bb.occupied); break;
+                case Queen: targets = Attacks::queen(from, bb.occupied); break;
+                default: targets = Attacks::king(from); break;
+            }
+            targets &= ~own;
+            while (targets) {
+                int to = popLsb(targets);
+                moves.push(Move(from, to, (enemy & squareBB(to)) ? Capture : Quiet));
+            }
+            if (type == King && colOf(from) == 4) {
+                for (int to : {from + 2, from - 2}) {
+                    int flag = castleFlag(from, to, us);
+                    if (flag >= 0) moves.push(Move(from, to, flag));
+                }
+            }
         }
-        return true;
     }
-    return false;
+
+    int legal = 0;
+    for (Move move : moves) {
+        if (isLegal(move)) moves[legal++] = move;
+    }
+    moves.resize(legal);
+}
+
+bool Board::isRookMoveValid(int startRow, int startCol, int endRow, int endCol) const {
+    Instrumentation::countPath(Instrumentation::RookPath, squareOf(startRow, startCol), squareOf(endRow, endCol));
+    return Attacks::rook(squareOf(startRow, startCol), bb.occupied) & squareBB(squareOf(endRow, endCol));
 }
 
 bool Board::isBishopMoveValid(int startRow, int startCol, int endRow, int endCol) const {
-    if (abs(startRow - endRow) != abs(startCol - endCol)) return false;
-    int rowDir = (endRow - startRow) / abs(endRow - startRow);
-    int colDir = (endCol - startCol) / abs(endCol - startCol);
-    for (int i = 1; i < abs(startRow - endRow); ++i) {
-        if (!grid[startRow + i * rowDir][startCol + i * colDir].empty()) return false;
-    }
-    return true;
+    Instrumentation::countPath(Instrumentation::BishopPath, squareOf(startRow, startCol), squareOf(endRow, endCol));
+    return Attacks::bishop(squareOf(startRow, startCol), bb.occupied) & squareBB(squareOf(endRow, endCol));
 }
 
 bool Board::isKnightMoveValid(int startRow, int startCol, int endRow, int endCol) {
@@ -199,9 +711,9 @@ bool Board::isKnightMoveValid(int startRow, int startCol, int endRow, int endCol
 }
 
 bool Board::isQueenMoveValid(int startRow, int startCol, int endRow, int endCol) const {
-    return isRookMoveValid(startRow, startCol, endRow, endCol) || isBishopMoveValid(startRow, startCol, endRow, endCol);
+    return Attacks::queen(squareOf(startRow, startCol), bb.occupied) & squareBB(squareOf(endRow, endCol));
 }
 
 bool Board::isKingMoveValid(int startRow, int startCol, int endRow, int endCol) {
     return abs(startRow - endRow) <= 1 && abs(startCol - endCol) <= 1;
-}
\ No newline at end of file
+}
@@ -0,0 +1,194 @@
+#include "include/Evaluate.h"
+#include "include/Nnue.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CHESS_HAS_X86_SIMD 1
+#endif
+
+namespace {
+    // Piece-square bonuses from White's point of view, written rank 8 first as on a diagram.
+    constexpr int8_t Bonus[7][64] = {
+        {},
+        { 0,  0,  0,  0,  0,  0,  0,  0,
+         50, 50, 50, 50, 50, 50, 50, 50,
+         10, 10, 20, 30, 30, 20, 10, 10,
+          5,  5, 10, 25, 25, 10,  5,  5,
+          0,  0,  0, 20, 20,  0,  0,  0,
+          5, -5,-10,  0,  0,-10, -5,  5,
+          5, 10, 10,-20,-20, 10, 10,  5,
+          0,  0,  0,  0,  0,  0,  0,  0},
+        {-50,-40,-30,-30,-30,-30,-40,-50,
+         -40,-20,  0,  0,  0,  0,-20,-40,
+         -30,  0, 10, 15, 15, 10,  0,-30,
+         -30,  5, 15, 20, 20, 15,  5,-30,
+         -30,  0, 15, 20, 20, 15,  0,-30,
+         -30,  5, 10, 15, 15, 10,  5,-30,
+         -40,-20,  0,  5,  5,  0,-20,-40,
+         -50,-40,-30,-30,-30,-30,-40,-50},
+        {-20,-10,-10,-10,-10,-10,-10,-20,
+         -10,  0,  0,  0,  0,  0,  0,-10,
+         -10,  0,  5, 10, 10,  5,  0,-10,
+         -10,  5,  5, 10, 10,  5,  5,-10,
+         -10,  0, 10, 10, 10, 10,  0,-10,
+         -10, 10, 10, 10, 10, 10, 10,-10,
+         -10,  5,  0,  0,  0,  0,  5,-10,
+         -20,-10,-10,-10,-10,-10,-10,-20},
+        {  0,  0,  0,  0,  0,  0,  0,  0,
+           5, 10, 10, 10, 10, 10, 10,  5,
+          -5,  0,  0,  0,  0,  0,  0, -5,
+          -5,  0,  0,  0,  0,  0,  0, -5,
+          -5,  0,  0,  0,  0,  0,  0, -5,
+          -5,  0,  0,  0,  0,  0,  0, -5,
+          -5,  0,  0,  0,  0,  0,  0, -5,
+           0,  0,  0,  5,  5,  0,  0,  0},
+        {-20,-10,-10, -5, -5,-10,-10,-20,
+         -10,  0,  0,  0,  0,  0,  0,-10,
+         -10,  0,  5,  5,  5,  5,  0,-10,
+          -5,  0,  5,  5,  5,  5,  0, -5,
+           0,  0,  5,  5,  5,  5,  0, -5,
+         -10,  5,  5,  5,  5,  5,  0,-10,
+         -10,  0,  5,  0,  0,  0,  0,-10,
+         -20,-10,-10, -5, -5,-10,-10,-20},
+        {-30,-40,-40,-50,-50,-40,-40,-30,
+         -30,-40,-40,-50,-50,-40,-40,-30,
+         -30,-40,-40,-50,-50,-40,-40,-30,
+         -30,-40,-40,-50,-50,-40,-40,-30,
+         -20,-30,-30,-40,-40,-30,-30,-20,
+         -10,-20,-20,-20,-20,-20,-20,-10,
+          20, 20,  0,  0,  0,  0, 20, 20,
+          20, 30, 10,  0,  0, 10, 30, 20},
+    };
+
+    // Material plus bonus for every piece code on every square, signed for White. Black reads
+    // White's table mirrored vertically. Unused piece codes stay zero, so an empty square adds nothing.
+    struct alignas(32) ScoreTable {
+        int16_t values[PieceCount][64];
+    };
+
+    constexpr ScoreTable Scores = [] {
+        ScoreTable table{};
+        for (PieceType type : {Pawn, Knight, Bishop, Rook, Queen, King}) {
+            for (int square = 0; square < 64; ++square) {
+                int white = PieceValues[type] + Bonus[type][squareOf(7 - rowOf(square), colOf(square))];
+                int black = PieceValues[type] + Bonus[type][square];
+                table.values[makePiece(White, type)][square] = static_cast<int16_t>(white);
+                table.values[makePiece(Black, type)][square] = static_cast<int16_t>(-black);
+            }
+        }
+        return table;
+    }();
+
+    constexpr Piece EvaluatedPieces[] = {
+        WhitePawn, WhiteKnight, WhiteBishop, WhiteRook, WhiteQueen, WhiteKing,
+        BlackPawn, BlackKnight, BlackBishop, BlackRook, BlackQueen, BlackKing
+    };
+
+    int scalarKernel(const Piece *squares) {
+        int score = 0;
+        for (int square = 0; square < 64; ++square) score += Scores.values[squares[square]][square];
+        return score;
+    }
+
+#ifdef CHESS_HAS_X86_SIMD
+    // Each 16-bit lane is one square; at most one piece code matches it, so selecting the table
+    // value with a compare mask cannot overflow. Lanes are widened to 32 bits before summing.
+    __attribute__((target("sse4.1")))
+    int sse41Kernel(const Piece *squares) {
+        __m128i sum = _mm_setzero_si128();
+        for (int chunk = 0; chunk < 64; chunk += 8) {
+            __m128i codes = _mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(squares + chunk)));
+            __m128i values = _mm_setzero_si128();
+            for (Piece piece : EvaluatedPieces) {
+                __m128i mask = _mm_cmpeq_epi16(codes, _mm_set1_epi16(piece));
+                __m128i row = _mm_load_si128(reinterpret_cast<const __m128i *>(&Scores.values[piece][chunk]));
+                values = _mm_or_si128(values, _mm_and_si128(mask, row));
+            }
+            sum = _mm_add_epi32(sum, _mm_madd_epi16(values, _mm_set1_epi16(1)));
+        }
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtsi128_si32(sum);
+    }
+
+    __attribute__((target("avx2")))
+    int avx2Kernel(const Piece *squares) {
+        __m256i sum = _mm256_setzero_si256();
+        for (int chunk = 0; chunk < 64; chunk += 16) {
+            __m256i codes = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(squares + chunk)));
+            __m256i values = _mm256_setzero_si256();
+            for (Piece piece : EvaluatedPieces) {
+                __m256i mask = _mm256_cmpeq_epi16(codes, _mm256_set1_epi16(piece));
+                __m256i row = _mm256_load_si256(reinterpret_cast<const __m256i *>(&Scores.values[piece][chunk]));
+                values = _mm256_or_si256(values, _mm256_and_si256(mask, row));
+            }
+            sum = _mm256_add_epi32(sum, _mm256_madd_epi16(values, _mm256_set1_epi16(1)));
+        }
+        __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+        half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+        half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtsi128_si32(half);
+    }
+#endif
+
+    using Kernel = int (*)(const Piece *);
+
+    Kernel kernelFor(EvalKernel kernel) {
+        switch (kernel) {
+#ifdef CHESS_HAS_X86_SIMD
+            case EvalKernel::Avx2: return avx2Kernel;
+            case EvalKernel::Sse41: return sse41Kernel;
+#endif
+            default: return scalarKernel;
+        }
+    }
+
+    EvalKernel selectKernel() {
+        for (EvalKernel kernel : {EvalKernel::Avx2, EvalKernel::Sse41}) {
+            if (evalKernelSupported(kernel)) return kernel;
+        }
+        return EvalKernel::Scalar;
+    }
+
+    const EvalKernel Active = selectKernel();
+    const Kernel ActiveKernel = kernelFor(Active);
+
+    int fromSideToMove(const Board &board, int score) {
+        return board.sideToMove() == White ? score : -score;
+    }
+}
+
+int pieceSquareScore(Piece piece, int square) {
+    return Scores.values[piece][square];
+}
+
+bool evalKernelSupported(EvalKernel kernel) {
+#ifdef CHESS_HAS_X86_SIMD
+    __builtin_cpu_init();
+    switch (kernel) {
+        case EvalKernel::Avx2: return __builtin_cpu_supports("avx2");
+        case EvalKernel::Sse41: return __builtin_cpu_supports("sse4.1");
+        default: return true;
+    }
+#else
+    return kernel == EvalKernel::Scalar;
+#endif
+}
+
+EvalKernel activeEvalKernel() {
+    return Active;
+}
+
+int evaluate(const Board &board) {
+    if (const Nnue::Accumulator *accumulator = board.accumulator()) return accumulator->evaluate(board.sideToMove());
+    return fromSideToMove(board, ActiveKernel(board.mailbox().data()) + evaluatePawns(board).score);
+}
+
+int evaluate(const Board &board, PawnHashTable &pawns) {
+    if (const Nnue::Accumulator *accumulator = board.accumulator()) return accumulator->evaluate(board.sideToMove());
+    return fromSideToMove(board, ActiveKernel(board.mailbox().data()) + pawns.probe(board).score);
+}
+
+int evaluate(const Board &board, EvalKernel kernel) {
+    return fromSideToMove(board, kernelFor(kernel)(board.mailbox().data()));
+}
@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <sstream>
+#include <vector>
+#include "include/Instrumentation.h"
+
+namespace Instrumentation {
+    namespace {
+        constexpr const char *CallNames[CallTypeCount] = {"movePawn", "moveRook", "moveBishop", "moveKnight", "moveQueen", "moveKing"};
+        constexpr const char *PathNames[PathTypeCount] = {"isRookMoveValid", "isBishopMoveValid"};
+
+        // Written only by the owning thread, so plain load/store pairs suffice; atomics make the
+        // concurrent reads in snapshot() well defined.
+        struct Counter {
+            std::atomic<uint64_t> value{0};
+
+            void add(uint64_t amount) { value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed); }
+            [[nodiscard]] uint64_t get() const { return value.load(std::memory_order_relaxed); }
+        };
+
+        struct ThreadCounters {
+            std::array<std::array<Counter, 3>, CallTypeCount> calls;  // accepted, rejected, nanoseconds
+            std::array<std::array<Counter, 2>, PathTypeCount> paths;  // checks, squares
+
+            void addTo(Snapshot &totals) const {
+                for (int i = 0; i < CallTypeCount; ++i) {
+                    totals.calls[i].accepted += calls[i][0].get();
+                    totals.calls[i].rejected += calls[i][1].get();
+                    totals.calls[i].nanoseconds += calls[i][2].get();
+                }
+                for (int i = 0; i < PathTypeCount; ++i) {
+                    totals.paths[i].checks += paths[i][0].get();
+                    totals.paths[i].squares += paths[i][1].get();
+                }
+            }
+        };
+
+        // reset() records a baseline instead of clearing counters other threads are writing.
+        struct Registry {
+            std::mutex mutex;
+            std::vector<const ThreadCounters *> live;
+            Snapshot retired;
+            Snapshot baseline;
+        };
+
+        Registry &registry() {
+            static Registry instance;
+            return instance;
+        }
+
+        Snapshot totals(Registry &shared) {
+            Snapshot result = shared.retired;
+            for (const ThreadCounters *counters : shared.live) counters->addTo(result);
+            return result;
+        }
+
+        struct Registration {
+            ThreadCounters counters;
+
+            Registration() {
+                std::lock_guard lock(registry().mutex);
+                registry().live.push_back(&counters);
+            }
+
+            ~Registration() {
+                Registry &shared = registry();
+                std::lock_guard lock(shared.mutex);
+                counters.addTo(shared.retired);
+                shared.live.erase(std::find(shared.live.begin(), shared.live.end(), &counters));
+            }
+        };
+
+        ThreadCounters &local() {
+            thread_local Registration registration;
+            return registration.counters;
+        }
+    }
+
+    void recordCall(CallType type, bool accepted, uint64_t nanoseconds) {
+        auto &counters = local().calls[type];
+        counters[accepted ? 0 : 1].add(1);
+        counters[2].add(nanoseconds);
+    }
+
+    void recordPath(PathType type, int squares) {
+        auto &counters = local().paths[type];
+        counters[0].add(1);
+        counters[1].add(squares);
+    }
+
+    Snapshot snapshot() {
+        Registry &shared = registry();
+        std::lock_guard lock(shared.mutex);
+        Snapshot result = totals(shared);
+        for (int i = 0; i < CallTypeCount; ++i) {
+            CallStats &stats = result.calls[i];
+            stats.accepted -= shared.baseline.calls[i].accepted;
+            stats.rejected -= shared.baseline.calls[i].rejected;
+            stats.nanoseconds -= shared.baseline.calls[i].nanoseconds;
+            stats.calls = stats.accepted + stats.rejected;
+        }
+        for (int i = 0; i < PathTypeCount; ++i) {
+            result.paths[i].checks -= shared.baseline.paths[i].checks;
+            result.paths[i].squares -= shared.baseline.paths[i].squares;
+        }
+        return result;
+    }
+
+    void reset() {
+        Registry &shared = registry();
+        std::lock_guard lock(shared.mutex);
+        shared.baseline = totals(shared);
+    }
+
+    std::string toText(const Snapshot &snapshot) {
+        std::ostringstream out;
+        for (int i = 0; i < CallTypeCount; ++i) {
+            const CallStats &stats = snapshot.calls[i];
+            out << CallNames[i] << ": calls " << stats.calls << "  accepted " << stats.accepted
+                << "  rejected " << stats.rejected << "  ns " << stats.nanoseconds
+                << "  ns/call " << (stats.calls ? stats.nanoseconds / stats.calls : 0) << "\n";
+        }
+        for (int i = 0; i < PathTypeCount; ++i) {
+            const PathStats &stats = snapshot.paths[i];
+            out << PathNames[i] << ": checks " << stats.checks << "  squares " << stats.squares << "\n";
+        }
+        return out.str();
+    }
+
+    std::string toJson(const Snapshot &snapshot) {
+        std::ostringstream out;
+        out << "{\"calls\":{";
+        for (int i = 0; i < CallTypeCount; ++i) {
+            const CallStats &stats = snapshot.calls[i];
+            out << (i ? "," : "") << "\"" << CallNames[i] << "\":{\"calls\":" << stats.calls
+                << ",\"accepted\":" << stats.accepted << ",\"rejected\":" << stats.rejected
+                << ",\"nanoseconds\":" << stats.nanoseconds << "}";
+        }
+        out << "},\"paths\":{";
+        for (int i = 0; i < PathTypeCount; ++i) {
+            const PathStats &stats = snapshot.paths[i];
+            out << (i ? "," : "") << "\"" << PathNames[i] << "\":{\"checks\":" << stats.checks
+                << ",\"squares\":" << stats.squares << "}";
+        }
+        out << "}}";
+        return out.str();
+    }
+}
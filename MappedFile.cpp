@@ -0,0 +1,68 @@
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "include/MappedFile.h"
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const char *path, bool sequential) {
+    close();
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info{};
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+    length = static_cast<size_t>(info.st_size);
+    if (length == 0) {
+        ::close(fd);
+        return true;
+    }
+
+    void *mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        length = 0;
+        return false;
+    }
+    if (sequential) madvise(mapping, length, MADV_SEQUENTIAL);
+    data = static_cast<const char *>(mapping);
+    return true;
+}
+
+void MappedFile::close() {
+    if (data) munmap(const_cast<char *>(data), length);
+    data = nullptr;
+    length = 0;
+    released = 0;
+}
+
+void MappedFile::release(size_t offset) {
+    auto page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t end = offset / page * page;
+    if (!data || end <= released) return;
+    madvise(const_cast<char *>(data) + released, end - released, MADV_DONTNEED);
+    released = end;
+}
+
+void MappedFile::release(size_t begin, size_t end) const {
+    auto page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t first = (begin + page - 1) / page * page;
+    size_t last = std::min(end, length) / page * page;
+    if (!data || last <= first) return;
+    madvise(const_cast<char *>(data) + first, last - first, MADV_DONTNEED);
+}
+
+std::string_view MappedFile::view() const {
+    return {data, length};
+}
+
+size_t MappedFile::size() const {
+    return length;
+}
@@ -0,0 +1,120 @@
+#include <algorithm>
+#include "include/Evaluate.h"
+#include "include/MoveOrdering.h"
+
+namespace {
+    constexpr int TTMoveScore = 1 << 30;
+    constexpr int CaptureScore = 1 << 24;
+    constexpr int PromotionScore = 1 << 23;
+    constexpr int KillerScore = 1 << 22;
+    constexpr int CounterMoveScore = KillerScore - 2;
+    constexpr int UnderPromotionScore = -(1 << 20);
+
+    Piece movedPiece(const Board &board, Move move) {
+        return board.pieceAt(rowOf(move.from()), colOf(move.from()));
+    }
+}
+
+void MoveOrdering::newSearch() {
+    killers = {};
+    for (auto &side : butterfly) {
+        for (auto &from : side) {
+            for (int16_t &score : from) score = static_cast<int16_t>(score / 2);
+        }
+    }
+}
+
+void MoveOrdering::clear() {
+    killers = {};
+    butterfly = {};
+    counters = {};
+}
+
+void MoveOrdering::setHeuristics(uint8_t heuristics) {
+    enabled = heuristics;
+}
+
+uint8_t MoveOrdering::heuristics() const {
+    return enabled;
+}
+
+// History gravity: a bonus moves the score toward +-MaxHistoryScore by a share of the remaining
+// distance, so frequent cutoffs saturate instead of overflowing and stale scores decay.
+void MoveOrdering::updateHistory(Color side, Move move, int bonus) {
+    int16_t &score = butterfly[side][move.from()][move.to()];
+    score = static_cast<int16_t>(score + bonus - score * std::abs(bonus) / MaxHistoryScore);
+}
+
+void MoveOrdering::updateQuiet(const Board &board, Move best, Move previous, int ply, int depth, std::span<const Move> triedQuiets) {
+    if (killers[ply][0] != best) {
+        killers[ply][1] = killers[ply][0];
+        killers[ply][0] = best;
+    }
+
+    Color side = board.sideToMove();
+    int bonus = std::min(depth * depth * 16, 1200);
+    updateHistory(side, best, bonus);
+    for (Move move : triedQuiets) {
+        if (move != best) updateHistory(side, move, -bonus);
+    }
+
+    // The previous move's piece now stands on its target square.
+    if (previous != Move{}) counters[board.pieceAt(rowOf(previous.to()), colOf(previous.to()))][previous.to()] = best;
+}
+
+Move MoveOrdering::killer(int ply, int slot) const {
+    return (enabled & UseKillers) ? killers[ply][slot] : Move{};
+}
+
+Move MoveOrdering::counterMove(const Board &board, Move previous) const {
+    if (!(enabled & UseCounterMoves) || previous == Move{}) return Move{};
+    return counters[board.pieceAt(rowOf(previous.to()), colOf(previous.to()))][previous.to()];
+}
+
+int MoveOrdering::history(Color side, Move move) const {
+    return (enabled & UseHistory) ? butterfly[side][move.from()][move.to()] : 0;
+}
+
+MovePicker::MovePicker(const Board &board, MoveList &moves, Move ttMove, const MoveOrdering *ordering, int ply, Move previous)
+    : moves(moves) {
+    Move killers[2] = {};
+    Move counter{};
+    if (ordering) {
+        killers[0] = ordering->killer(ply, 0);
+        killers[1] = ordering->killer(ply, 1);
+        counter = ordering->counterMove(board, previous);
+    }
+
+    for (int i = 0; i < moves.size(); ++i) {
+        Move move = moves[i];
+        if (move == ttMove) {
+            scores[i] = TTMoveScore;
+        } else if (move.isCapture()) {
+            Piece victim = move.flag() == EnPassant ? WhitePawn : board.pieceAt(rowOf(move.to()), colOf(move.to()));
+            scores[i] = CaptureScore + 10 * PieceValues[typeOf(victim)] - typeOf(movedPiece(board, move));
+            if (move.isPromotion()) scores[i] += PieceValues[move.promotionType()];
+        } else if (move.isPromotion()) {
+            scores[i] = move.promotionType() == Queen ? PromotionScore : UnderPromotionScore + move.promotionType();
+        } else if (move == killers[0]) {
+            scores[i] = KillerScore;
+        } else if (move == killers[1]) {
+            scores[i] = KillerScore - 1;
+        } else if (move == counter) {
+            scores[i] = CounterMoveScore;
+        } else {
+            scores[i] = ordering ? ordering->history(board.sideToMove(), move) : 0;
+        }
+    }
+}
+
+bool MovePicker::next(Move &move) {
+    if (current == moves.size()) return false;
+    int best = current;
+    for (int i = current + 1; i < moves.size(); ++i) {
+        if (scores[i] > scores[best]) best = i;
+    }
+    std::swap(moves[current], moves[best]);
+    std::swap(scores[current], scores[best]);
+    move = moves[current++];
+    return true;
+}
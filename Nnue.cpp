@@ -0,0 +1,153 @@
+#include <cstring>
+#include <fstream>
+#include "include/Board.h"
+#include "include/MappedFile.h"
+#include "include/Nnue.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CHESS_HAS_X86_SIMD 1
+#endif
+
+namespace Nnue {
+
+    namespace {
+        constexpr char Magic[4] = {'C', 'N', 'U', 'E'};
+        constexpr uint32_t Version = 1;
+
+        struct Header {
+            char magic[4];
+            uint32_t version;
+            uint32_t hidden;
+        };
+
+#ifdef CHESS_HAS_X86_SIMD
+        const bool UseAvx2 = [] {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") != 0;
+        }();
+
+        __attribute__((target("avx2")))
+        void addColumnAvx2(int16_t *values, const int16_t *column) {
+            for (int i = 0; i < Hidden; i += 16) {
+                auto *lane = reinterpret_cast<__m256i *>(values + i);
+                _mm256_store_si256(lane, _mm256_add_epi16(_mm256_load_si256(lane), _mm256_load_si256(reinterpret_cast<const __m256i *>(column + i))));
+            }
+        }
+
+        __attribute__((target("avx2")))
+        void subColumnAvx2(int16_t *values, const int16_t *column) {
+            for (int i = 0; i < Hidden; i += 16) {
+                auto *lane = reinterpret_cast<__m256i *>(values + i);
+                _mm256_store_si256(lane, _mm256_sub_epi16(_mm256_load_si256(lane), _mm256_load_si256(reinterpret_cast<const __m256i *>(column + i))));
+            }
+        }
+
+        // Clipped activations times output weights; products fit int32 and are summed by madd.
+        __attribute__((target("avx2")))
+        int32_t outputAvx2(const int16_t *values, const int16_t *weights) {
+            __m256i sum = _mm256_setzero_si256();
+            __m256i zero = _mm256_setzero_si256();
+            __m256i ceiling = _mm256_set1_epi16(QA);
+            for (int i = 0; i < Hidden; i += 16) {
+                __m256i clipped = _mm256_min_epi16(_mm256_max_epi16(_mm256_load_si256(reinterpret_cast<const __m256i *>(values + i)), zero), ceiling);
+                sum = _mm256_add_epi32(sum, _mm256_madd_epi16(clipped, _mm256_load_si256(reinterpret_cast<const __m256i *>(weights + i))));
+            }
+            __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+            half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+            half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+            return _mm_cvtsi128_si32(half);
+        }
+#else
+        constexpr bool UseAvx2 = false;
+        void addColumnAvx2(int16_t *, const int16_t *) {}
+        void subColumnAvx2(int16_t *, const int16_t *) {}
+        int32_t outputAvx2(const int16_t *, const int16_t *) { return 0; }
+#endif
+
+        void addColumn(int16_t *values, const int16_t *column) {
+            if (UseAvx2) return addColumnAvx2(values, column);
+            for (int i = 0; i < Hidden; ++i) values[i] = static_cast<int16_t>(values[i] + column[i]);
+        }
+
+        void subColumn(int16_t *values, const int16_t *column) {
+            if (UseAvx2) return subColumnAvx2(values, column);
+            for (int i = 0; i < Hidden; ++i) values[i] = static_cast<int16_t>(values[i] - column[i]);
+        }
+
+        int32_t output(const int16_t *values, const int16_t *weights) {
+            if (UseAvx2) return outputAvx2(values, weights);
+            int32_t sum = 0;
+            for (int i = 0; i < Hidden; ++i) {
+                int clipped = values[i] < 0 ? 0 : values[i] > QA ? QA : values[i];
+                sum += clipped * weights[i];
+            }
+            return sum;
+        }
+    }
+
+    bool load(Network &network, const char *path) {
+        MappedFile file;
+        if (!file.open(path)) return false;
+        std::string_view data = file.view();
+
+        Header header{};
+        if (data.size() != sizeof(Header) + sizeof(network.featureWeights) + sizeof(network.featureBias)
+                           + sizeof(network.outputWeights) + sizeof(network.outputBias)) return false;
+        std::memcpy(&header, data.data(), sizeof(Header));
+        if (std::memcmp(header.magic, Magic, 4) != 0 || header.version != Version || header.hidden != Hidden) return false;
+
+        const char *p = data.data() + sizeof(Header);
+        auto read = [&p](void *field, size_t size) {
+            std::memcpy(field, p, size);
+            p += size;
+        };
+        read(network.featureWeights, sizeof(network.featureWeights));
+        read(network.featureBias, sizeof(network.featureBias));
+        read(network.outputWeights, sizeof(network.outputWeights));
+        read(&network.outputBias, sizeof(network.outputBias));
+        return true;
+    }
+
+    bool save(const Network &network, const char *path) {
+        std::ofstream out(path, std::ios::binary);
+        Header header{{Magic[0], Magic[1], Magic[2], Magic[3]}, Version, Hidden};
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char *>(network.featureWeights), sizeof(network.featureWeights));
+        out.write(reinterpret_cast<const char *>(network.featureBias), sizeof(network.featureBias));
+        out.write(reinterpret_cast<const char *>(network.outputWeights), sizeof(network.outputWeights));
+        out.write(reinterpret_cast<const char *>(&network.outputBias), sizeof(network.outputBias));
+        return static_cast<bool>(out);
+    }
+
+    Accumulator::Accumulator(const Network &network) : network(&network) {
+        for (auto &perspective : values) std::memcpy(perspective, network.featureBias, sizeof(perspective));
+    }
+
+    void Accumulator::refresh(const Board &board) {
+        for (auto &perspective : values) std::memcpy(perspective, network->featureBias, sizeof(perspective));
+        const auto &squares = board.mailbox();
+        for (int square = 0; square < 64; ++square) {
+            if (squares[square] != NoPiece) add(squares[square], square);
+        }
+    }
+
+    void Accumulator::add(Piece piece, int square) {
+        for (Color perspective : {White, Black}) {
+            addColumn(values[perspective], network->featureWeights[featureIndex(perspective, piece, square)]);
+        }
+    }
+
+    void Accumulator::remove(Piece piece, int square) {
+        for (Color perspective : {White, Black}) {
+            subColumn(values[perspective], network->featureWeights[featureIndex(perspective, piece, square)]);
+        }
+    }
+
+    int Accumulator::evaluate(Color sideToMove) const {
+        int64_t sum = output(values[sideToMove], network->outputWeights[0])
+                    + output(values[opposite(sideToMove)], network->outputWeights[1])
+                    + network->outputBias;
+        return static_cast<int>(sum * EvalScale / (QA * QB));
+    }
+}
@@ -0,0 +1,99 @@
+#include <algorithm>
+#include "include/ParallelSearch.h"
+
+ParallelSearch::ParallelSearch(TranspositionTable &table, int threads) : tt(table) {
+    setThreads(threads);
+}
+
+ParallelSearch::~ParallelSearch() {
+    stop();
+    wait();
+}
+
+void ParallelSearch::setThreads(int threads) {
+    workers.clear();
+    for (int i = 0; i < std::max(1, threads); ++i) {
+        workers.push_back(std::make_unique<Search>(tt));
+        workers.back()->joinGroup(i, stopFlag);
+        workers.back()->setNetwork(network);
+        workers.back()->setTablebases(tablebases);
+    }
+    workers[0]->onIteration([this](const SearchInfo &info) {
+        if (!iterationCallback) return;
+        uint64_t total = nodeCount();
+        iterationCallback({info.depth, info.score, total, info.timeMs, info.timeMs > 0 ? total * 1000 / info.timeMs : total, info.pv});
+    });
+    results.assign(workers.size(), SearchResult{});
+}
+
+int ParallelSearch::threads() const {
+    return static_cast<int>(workers.size());
+}
+
+void ParallelSearch::onIteration(std::function<void(const SearchInfo &)> callback) {
+    iterationCallback = std::move(callback);
+}
+
+void ParallelSearch::setNetwork(const Nnue::Network *net) {
+    network = net;
+    for (const auto &worker : workers) worker->setNetwork(network);
+}
+
+void ParallelSearch::setTablebases(const Tablebases *tables) {
+    tablebases = tables;
+    for (const auto &worker : workers) worker->setTablebases(tablebases);
+}
+
+void ParallelSearch::start(const Board &root, const SearchLimits &limits, std::span<const uint64_t> history) {
+    wait();
+    stopFlag.store(false, std::memory_order_relaxed);
+    tt.newSearch();
+    historyCopy.assign(history.begin(), history.end());
+
+    running.emplace_back([this, root, limits] {
+        results[0] = workers[0]->run(root, limits, historyCopy);
+        stopFlag.store(true, std::memory_order_relaxed);
+    });
+    for (size_t i = 1; i < workers.size(); ++i) {
+        running.emplace_back([this, root, i] {
+            results[i] = workers[i]->run(root, {}, historyCopy);
+        });
+    }
+}
+
+SearchResult ParallelSearch::wait() {
+    for (std::thread &thread : running) thread.join();
+    bool searched = !running.empty();
+    running.clear();
+    if (!searched) return results[0];
+
+    // A result at depth 0 never finished an iteration; worker 0's is kept if none did.
+    SearchResult best = results[0];
+    for (size_t i = 1; i < results.size(); ++i) {
+        if (results[i].depth > best.depth && results[i].pv.length > 0) best = results[i];
+    }
+    best.nodes = 0;
+    for (const SearchResult &result : results) best.nodes += result.nodes;
+    best.timeMs = results[0].timeMs;
+    best.nps = best.timeMs > 0 ? best.nodes * 1000 / best.timeMs : best.nodes;
+    return best;
+}
+
+SearchResult ParallelSearch::run(const Board &root, const SearchLimits &limits, std::span<const uint64_t> history) {
+    start(root, limits, history);
+    return wait();
+}
+
+void ParallelSearch::stop() {
+    stopFlag.store(true, std::memory_order_relaxed);
+}
+
+bool ParallelSearch::searching() const {
+    return !running.empty() && !stopFlag.load(std::memory_order_relaxed);
+}
+
+uint64_t ParallelSearch::nodeCount() const {
+    uint64_t total = 0;
+    for (const auto &worker : workers) total += worker->nodeCount();
+    return total;
+}
@@ -0,0 +1,111 @@
+#include <algorithm>
+#include <bit>
+#include "include/PawnStructure.h"
+
+namespace {
+    constexpr Bitboard fileBB(int col) {
+        return FileA << col;
+    }
+
+    constexpr Bitboard AdjacentFiles[8] = {
+        fileBB(1), fileBB(0) | fileBB(2), fileBB(1) | fileBB(3), fileBB(2) | fileBB(4),
+        fileBB(3) | fileBB(5), fileBB(4) | fileBB(6), fileBB(5) | fileBB(7), fileBB(6)
+    };
+
+    // Squares strictly in front of a square (from color's point of view) on its own file and the
+    // files beside it: a pawn with no enemy pawns there is passed.
+    constexpr std::array<std::array<Bitboard, 64>, 2> PassedSpan = [] {
+        std::array<std::array<Bitboard, 64>, 2> span{};
+        for (int square = 0; square < 64; ++square) {
+            Bitboard files = fileBB(colOf(square)) | AdjacentFiles[colOf(square)];
+            for (int row = 0; row < 8; ++row) {
+                Bitboard rank = 0xFFull << (row * 8);
+                if (row > rowOf(square)) span[White][square] |= files & rank;
+                if (row < rowOf(square)) span[Black][square] |= files & rank;
+            }
+        }
+        return span;
+    }();
+
+    int evaluateSide(Color us, Bitboard own, Bitboard enemy, Bitboard &passed) {
+        int score = 0;
+        Bitboard enemyAttacks = pawnAttacks(opposite(us), enemy);
+        for (int col = 0; col < 8; ++col) {
+            int count = popCount(own & fileBB(col));
+            if (count > 1) score -= DoubledPawnPenalty * (count - 1);
+        }
+
+        for (Bitboard pawns = own; pawns;) {
+            int square = popLsb(pawns);
+            int col = colOf(square);
+            int relativeRow = us == White ? rowOf(square) : 7 - rowOf(square);
+            Bitboard neighbours = own & AdjacentFiles[col];
+
+            if (!neighbours) {
+                score -= IsolatedPawnPenalty;
+            } else if (relativeRow < 7) {
+                // Backward: every neighbour is ahead, and the stop square is held by an enemy pawn.
+                // A pawn on its last rank (only reachable through a hand-written FEN) has no stop square.
+                Bitboard supportZone = AdjacentFiles[col] & ~PassedSpan[us][square];
+                int stop = square + (us == White ? 8 : -8);
+                if (!(neighbours & supportZone) && (enemyAttacks & squareBB(stop))) score -= BackwardPawnPenalty;
+            }
+
+            if (!(enemy & PassedSpan[us][square])) {
+                passed |= squareBB(square);
+                score += PassedPawnBonus[relativeRow];
+            }
+        }
+        return score;
+    }
+}
+
+PawnEntry evaluatePawns(const Board &board) {
+    const Bitboards &bb = board.bitboards();
+    Bitboard white = bb.of(White, Pawn);
+    Bitboard black = bb.of(Black, Pawn);
+    PawnEntry entry{board.pawnHash(), 0, 0};
+    int score = evaluateSide(White, white, black, entry.passed) - evaluateSide(Black, black, white, entry.passed);
+    entry.score = static_cast<int16_t>(score);
+    return entry;
+}
+
+PawnHashTable::PawnHashTable(size_t kilobytes) {
+    size_t count = std::bit_floor(std::max<size_t>(1, kilobytes * 1024 / sizeof(PawnEntry)));
+    entries.resize(count);
+    mask = count - 1;
+    clear();
+}
+
+const PawnEntry &PawnHashTable::probe(const Board &board) {
+    ++probeCount;
+    PawnEntry &entry = entries[board.pawnHash() & mask];
+    if (entry.key == board.pawnHash()) {
+        ++hitCount;
+    } else {
+        entry = evaluatePawns(board);
+    }
+    return entry;
+}
+
+// Zero-filled entries are valid: key 0 is the pawnless position, which scores 0 with no passers.
+void PawnHashTable::clear() {
+    std::fill(entries.begin(), entries.end(), PawnEntry{});
+}
+
+uint64_t PawnHashTable::probes() const {
+    return probeCount;
+}
+
+uint64_t PawnHashTable::hits() const {
+    return hitCount;
+}
+
+int PawnHashTable::hitRate() const {
+    return probeCount ? static_cast<int>(hitCount * 1000 / probeCount) : 0;
+}
+
+void PawnHashTable::resetCounters() {
+    probeCount = 0;
+    hitCount = 0;
+}
@@ -0,0 +1,120 @@
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "include/Perft.h"
+
+const std::array<PerftReference, 6> PerftReferences = {{
+    {"startpos", StartFEN,
+     {20, 400, 8902, 197281, 4865609, 119060324}, 6},
+    {"kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+     {48, 2039, 97862, 4085603, 193690690}, 5},
+    {"position3", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+     {14, 191, 2812, 43238, 674624, 11030083}, 6},
+    {"position4", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+     {6, 264, 9467, 422333, 15833292}, 5},
+    {"position5", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+     {44, 1486, 62379, 2103487, 89941194}, 5},
+    {"position6", "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+     {46, 2079, 89890, 3894594, 164075551}, 5},
+}};
+
+uint64_t perft(Board &board, int depth) {
+    MoveList moves;
+    board.generateLegalMoves(moves);
+    if (depth <= 1) return depth == 1 ? moves.size() : 1;
+
+    uint64_t nodes = 0;
+    for (Move move : moves) {
+        Undo undo = board.makeMove(move);
+        nodes += perft(board, depth - 1);
+        board.unmakeMove(move, undo);
+    }
+    return nodes;
+}
+
+namespace {
+    struct PerftTask {
+        Board board;
+        int depth;
+    };
+
+    // Owner pushes and pops at the back, thieves take from the front where the oldest tasks are.
+    class TaskDeque {
+    public:
+        void push(PerftTask task) {
+            std::lock_guard lock(mutex);
+            tasks.push_back(std::move(task));
+        }
+
+        bool pop(PerftTask &task) {
+            std::lock_guard lock(mutex);
+            if (tasks.empty()) return false;
+            task = std::move(tasks.back());
+            tasks.pop_back();
+            return true;
+        }
+
+        bool steal(PerftTask &task) {
+            std::lock_guard lock(mutex);
+            if (tasks.empty()) return false;
+            task = std::move(tasks.front());
+            tasks.pop_front();
+            return true;
+        }
+
+    private:
+        std::mutex mutex;
+        std::deque<PerftTask> tasks;
+    };
+
+    // Enough tasks per thread that stealing can even out subtrees of very different sizes.
+    constexpr size_t TasksPerThread = 32;
+}
+
+uint64_t parallelPerft(const Board &board, int depth, int threads) {
+    threads = std::max(1, threads);
+    if (threads == 1 || depth <= 2) {
+        Board copy = board;
+        return perft(copy, depth);
+    }
+
+    // Expand breadth-first until there are enough tasks, keeping at least two plies per task.
+    std::vector<PerftTask> frontier{{board, depth}};
+    while (!frontier.empty() && frontier.size() < TasksPerThread * threads && frontier.front().depth > 3) {
+        std::vector<PerftTask> next;
+        for (PerftTask &task : frontier) {
+            MoveList moves;
+            task.board.generateLegalMoves(moves);
+            for (Move move : moves) {
+                next.push_back({task.board, task.depth - 1});
+                next.back().board.makeMove(move);
+            }
+        }
+        frontier = std::move(next);
+    }
+
+    std::vector<TaskDeque> deques(threads);
+    for (size_t i = 0; i < frontier.size(); ++i) deques[i % threads].push(std::move(frontier[i]));
+
+    std::atomic<uint64_t> total{0};
+    auto worker = [&](int index) {
+        uint64_t nodes = 0;
+        PerftTask task;
+        for (;;) {
+            bool found = deques[index].pop(task);
+            for (int i = 1; !found && i < threads; ++i) found = deques[(index + i) % threads].steal(task);
+            if (!found) break;
+            nodes += perft(task.board, task.depth);
+        }
+        total.fetch_add(nodes, std::memory_order_relaxed);
+    };
+
+    std::vector<std::thread> pool;
+    for (int i = 1; i < threads; ++i) pool.emplace_back(worker, i);
+    worker(0);
+    for (std::thread &thread : pool) thread.join();
+    return total.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,227 @@
+#include <cstring>
+#include "include/Pgn.h"
+
+namespace {
+    bool isSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    bool isResult(std::string_view token) {
+        return token == "1-0" || token == "0-1" || token == "1/2-1/2" || token == "*";
+    }
+
+    // [Name "value"]; anything else is dropped.
+    void parseTag(std::string_view line, PgnGame &game) {
+        size_t nameStart = 1;
+        while (nameStart < line.size() && isSpace(line[nameStart])) ++nameStart;
+        size_t nameEnd = nameStart;
+        while (nameEnd < line.size() && !isSpace(line[nameEnd]) && line[nameEnd] != '"') ++nameEnd;
+        size_t open = line.find('"', nameEnd);
+        size_t close = line.rfind('"');
+        if (nameEnd == nameStart || open == std::string_view::npos || close == open) return;
+        if (game.tagCount == PgnGame::MaxTags) return;
+        game.tags[game.tagCount++] = {line.substr(nameStart, nameEnd - nameStart), line.substr(open + 1, close - open - 1)};
+    }
+}
+
+std::string_view PgnGame::tag(std::string_view name) const {
+    for (int i = 0; i < tagCount; ++i) {
+        if (tags[i].name == name) return tags[i].value;
+    }
+    return {};
+}
+
+PgnReader::PgnReader(std::string_view text) : text(text) {}
+
+bool PgnReader::next(PgnGame &game) {
+    game.tagCount = 0;
+    game.movetext = {};
+    auto skipSpace = [this] {
+        while (pos < text.size() && isSpace(text[pos])) ++pos;
+    };
+
+    skipSpace();
+    if (pos >= text.size()) return false;
+
+    while (pos < text.size() && text[pos] == '[') {
+        size_t end = text.find('\n', pos);
+        if (end == std::string_view::npos) end = text.size();
+        parseTag(text.substr(pos, end - pos), game);
+        pos = end;
+        skipSpace();
+    }
+
+    size_t start = pos;
+    bool inComment = false;
+    bool lineStart = false;
+    for (; pos < text.size(); ++pos) {
+        char c = text[pos];
+        if (c == '\n') {
+            lineStart = true;
+            continue;
+        }
+        if (c == '[' && lineStart && !inComment) break;
+        if (c == '{') inComment = true;
+        else if (c == '}') inComment = false;
+        if (!isSpace(c)) lineStart = false;
+    }
+
+    size_t end = pos;
+    while (end > start && isSpace(text[end - 1])) --end;
+    game.movetext = text.substr(start, end - start);
+    return true;
+}
+
+size_t PgnReader::position() const {
+    return pos;
+}
+
+size_t findGameStart(std::string_view text, size_t offset) {
+    // PgnReader reads whatever comes first as a game, tag section or not.
+    if (offset == 0) {
+        size_t first = 0;
+        while (first < text.size() && isSpace(text[first])) ++first;
+        return first;
+    }
+
+    size_t line = offset;
+    if (line > 0 && text[line - 1] != '\n') {
+        line = text.find('\n', line);
+        line = line == std::string_view::npos ? text.size() : line + 1;
+    }
+
+    while (line < text.size()) {
+        if (text[line] == '[') {
+            size_t previous = line;
+            while (previous > 0 && isSpace(text[previous - 1])) --previous;
+            if (previous == 0) return line;
+            size_t previousLine = text.rfind('\n', previous - 1);
+            previousLine = previousLine == std::string_view::npos ? 0 : previousLine + 1;
+            while (isSpace(text[previousLine])) ++previousLine;
+            if (text[previousLine] != '[') return line;
+        }
+        line = text.find('\n', line);
+        line = line == std::string_view::npos ? text.size() : line + 1;
+    }
+    return text.size();
+}
+
+Move parseSan(const Board &board, std::string_view san) {
+    while (!san.empty() && std::strchr("+#!?", san.back())) san.remove_suffix(1);
+    if (san.size() < 2) return Move{};
+
+    MoveList moves;
+    board.generateLegalMoves(moves);
+
+    if (san == "O-O" || san == "0-0" || san == "O-O-O" || san == "0-0-0") {
+        int flag = san.size() == 3 ? KingCastle : QueenCastle;
+        for (Move move : moves) {
+            if (move.flag() == flag) return move;
+        }
+        return Move{};
+    }
+
+    PieceType type = Pawn;
+    size_t begin = 0;
+    if (std::strchr("NBRQK", san[0])) {
+        type = typeOf(pieceFromChar(san[0]));
+        begin = 1;
+    }
+
+    PieceType promotion = NoPieceType;
+    size_t end = san.size();
+    if (type == Pawn && std::strchr("NBRQ", san[end - 1])) {
+        promotion = typeOf(pieceFromChar(san[--end]));
+        if (end > 0 && san[end - 1] == '=') --end;
+    }
+    if (end < begin + 2) return Move{};
+
+    char file = san[end - 2];
+    char rank = san[end - 1];
+    if (file < 'a' || file > 'h' || rank < '1' || rank > '8') return Move{};
+    int to = squareOf(rank - '1', file - 'a');
+
+    int fromCol = -1;
+    int fromRow = -1;
+    for (size_t i = begin; i < end - 2; ++i) {
+        char c = san[i];
+        if (c >= 'a' && c <= 'h') fromCol = c - 'a';
+        else if (c >= '1' && c <= '8') fromRow = c - '1';
+        else if (c != 'x') return Move{};
+    }
+
+    Move found{};
+    int matches = 0;
+    for (Move move : moves) {
+        if (move.to() != to || move.isCastle()) continue;
+        if (typeOf(board.pieceAt(rowOf(move.from()), colOf(move.from()))) != type) continue;
+        if ((move.isPromotion() ? move.promotionType() : NoPieceType) != promotion) continue;
+        if (fromCol >= 0 && colOf(move.from()) != fromCol) continue;
+        if (fromRow >= 0 && rowOf(move.from()) != fromRow) continue;
+        found = move;
+        ++matches;
+    }
+    return matches == 1 ? found : Move{};
+}
+
+bool replayGame(const PgnGame &game, Board &board, int &plies, std::string_view *failedToken,
+                const std::function<void(const Board &, Move)> &onMove) {
+    plies = 0;
+    board = Board();
+    std::string_view fen = game.tag("FEN");
+    if (fen.empty()) {
+        board.initialize();
+    } else if (!board.fromFEN(fen)) {
+        return false;
+    }
+
+    std::string_view text = game.movetext;
+    size_t pos = 0;
+    int variationDepth = 0;
+    while (pos < text.size()) {
+        char c = text[pos];
+        if (isSpace(c)) {
+            ++pos;
+        } else if (c == '{') {
+            pos = text.find('}', pos);
+            if (pos == std::string_view::npos) return false;
+            ++pos;
+        } else if (c == ';') {
+            pos = text.find('\n', pos);
+            if (pos == std::string_view::npos) pos = text.size();
+        } else if (c == '(') {
+            ++variationDepth;
+            ++pos;
+        } else if (c == ')') {
+            if (variationDepth == 0) return false;
+            --variationDepth;
+            ++pos;
+        } else {
+            size_t end = pos;
+            while (end < text.size() && !isSpace(text[end]) && !std::strchr("{;()", text[end])) ++end;
+            std::string_view token = text.substr(pos, end - pos);
+            pos = end;
+            if (variationDepth > 0 || token[0] == '$') continue;
+            if (isResult(token)) break;
+
+            // "12." and "12..." as separate tokens or glued to the move ("12.e4").
+            size_t digits = 0;
+            while (digits < token.size() && token[digits] >= '0' && token[digits] <= '9') ++digits;
+            if (digits > 0 && digits < token.size() && token[digits] == '.') {
+                while (digits < token.size() && token[digits] == '.') ++digits;
+                token.remove_prefix(digits);
+                if (token.empty()) continue;
+            }
+
+            Move move = parseSan(board, token);
+            if (move == Move{}) {
+                if (failedToken) *failedToken = token;
+                return false;
+            }
+            if (onMove) onMove(board, move);
+            board.makeMove(move);
+            ++plies;
+        }
+    }
+    return variationDepth == 0;
+}
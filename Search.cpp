@@ -0,0 +1,282 @@
+#include <algorithm>
+#include "include/Evaluate.h"
+#include "include/Search.h"
+
+namespace {
+    // Mate scores are stored relative to the node so they stay valid at any ply.
+    int scoreToTT(int score, int ply) {
+        if (score >= MateInMaxPly) return score + ply;
+        if (score <= -MateInMaxPly) return score - ply;
+        return score;
+    }
+
+    int scoreFromTT(int score, int ply) {
+        if (score >= MateInMaxPly) return score - ply;
+        if (score <= -MateInMaxPly) return score + ply;
+        return score;
+    }
+
+    // Tablebase mates past the search horizon are clamped just below the mate range.
+    int tablebaseScore(const TablebaseResult &result, int ply) {
+        if (result.wdl == 0) return 0;
+        int distance = ply + result.plies;
+        int score = distance < MaxPly ? MateScore - distance : MateInMaxPly - 1;
+        return result.wdl > 0 ? score : -score;
+    }
+}
+
+Search::Search(TranspositionTable &table) : tt(table) {}
+
+void Search::stop() {
+    stopFlag->store(true, std::memory_order_relaxed);
+}
+
+void Search::joinGroup(int index, std::atomic<bool> &groupStop) {
+    threadIndex = index;
+    stopFlag = &groupStop;
+}
+
+uint64_t Search::nodeCount() const {
+    return nodes.load(std::memory_order_relaxed);
+}
+
+bool Search::isStopped() const {
+    return stopFlag->load(std::memory_order_relaxed);
+}
+
+// Only this thread writes the counter; other threads may read it for progress reports.
+void Search::countNode() {
+    nodes.store(nodes.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void Search::onIteration(std::function<void(const SearchInfo &)> callback) {
+    iterationCallback = std::move(callback);
+}
+
+int64_t Search::elapsedMs() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+void Search::setNetwork(const Nnue::Network *network) {
+    board.attachAccumulator(nullptr);
+    if (network) accumulator.emplace(*network);
+    else accumulator.reset();
+}
+
+void Search::setTablebases(const Tablebases *tables) {
+    tablebases = tables;
+}
+
+MoveOrdering &Search::moveOrdering() {
+    return ordering;
+}
+
+PawnHashTable &Search::pawnTable() {
+    return pawns;
+}
+
+SearchResult Search::run(const Board &root, const SearchLimits &searchLimits, std::span<const uint64_t> history) {
+    board = root;
+    if (accumulator) board.attachAccumulator(&*accumulator);
+    limits = searchLimits;
+    ordering.newSearch();
+    nodes.store(0, std::memory_order_relaxed);
+    limitsActive = false;
+    startTime = std::chrono::steady_clock::now();
+
+    size_t kept = std::min<size_t>(history.size(), MaxHistory);
+    std::copy(history.end() - static_cast<long>(kept), history.end(), keys.begin());
+    keyBase = static_cast<int>(kept);
+
+    if (stopFlag == &ownStop) {
+        ownStop.store(false, std::memory_order_relaxed);
+        tt.newSearch();
+    }
+    SearchResult result;
+    MoveList rootMoves;
+    board.generateLegalMoves(rootMoves);
+    if (rootMoves.empty()) {
+        result.score = board.isKingInCheck(board.sideToMove()) ? -MateScore : 0;
+        return result;
+    }
+    result.bestMove = rootMoves[0];
+
+    for (int iteration = 1; iteration <= limits.depth; ++iteration) {
+        int depth = std::min(iteration + (threadIndex & 1), MaxPly - 1);
+        int score = negamax(depth, -InfiniteScore, InfiniteScore, 0);
+        // An aborted iteration has a partial tree behind it; keep the last finished one, or none.
+        if (isStopped()) break;
+
+        result.depth = depth;
+        result.score = score;
+        result.pv = pvTable[0];
+        if (result.pv.length > 0) result.bestMove = result.pv.moves[0];
+        limitsActive = true;
+
+        int64_t timeMs = elapsedMs();
+        if (iterationCallback) {
+            uint64_t count = nodeCount();
+            iterationCallback({depth, score, count, timeMs, timeMs > 0 ? count * 1000 / timeMs : count, result.pv});
+        }
+        if (isStopped() || depth >= MaxPly - 1) break;
+        if (limits.movetimeMs && timeMs * 2 >= limits.movetimeMs) break; // the next iteration would not finish
+    }
+
+    result.nodes = nodeCount();
+    result.timeMs = elapsedMs();
+    result.nps = result.timeMs > 0 ? result.nodes * 1000 / result.timeMs : result.nodes;
+    return result;
+}
+
+bool Search::shouldStop() {
+    if (isStopped()) return true;
+    if (!limitsActive) return false;
+    uint64_t count = nodeCount();
+    if ((limits.nodes && count >= limits.nodes) || (limits.movetimeMs && (count & 2047) == 0 && elapsedMs() >= limits.movetimeMs)) {
+        stop();
+        return true;
+    }
+    return false;
+}
+
+bool Search::isRepetition(int ply) const {
+    int index = keyBase + ply;
+    int reach = std::min(board.halfmoveClock(), index);
+    for (int i = index - 4; i >= index - reach; i -= 2) {
+        if (keys[i] == keys[index]) return true;
+    }
+    return false;
+}
+
+void Search::updatePv(int ply, Move move) {
+    PrincipalVariation &pv = pvTable[ply];
+    const PrincipalVariation &child = pvTable[ply + 1];
+    pv.moves[0] = move;
+    std::copy(child.moves.begin(), child.moves.begin() + child.length, pv.moves.begin() + 1);
+    pv.length = child.length + 1;
+}
+
+int Search::negamax(int depth, int alpha, int beta, int ply) {
+    pvTable[ply].length = 0;
+    if (shouldStop()) return 0;
+
+    bool rootNode = ply == 0;
+    keys[keyBase + ply] = board.hash();
+    if (!rootNode) {
+        if (board.halfmoveClock() >= 100 || isRepetition(ply)) return 0;
+        if (ply >= MaxPly - 1) return evaluate(board, pawns);
+
+        // Mate distance pruning: no line from here can beat a shorter mate already found.
+        alpha = std::max(alpha, -MateScore + ply);
+        beta = std::min(beta, MateScore - ply - 1);
+        if (alpha >= beta) return alpha;
+
+        TablebaseResult result;
+        if (tablebases && popCount(board.bitboards().occupied) <= tablebases->maxPieces()
+            && board.probeTablebase(*tablebases, result)) {
+            return tablebaseScore(result, ply);
+        }
+    }
+
+    bool inCheck = board.isKingInCheck(board.sideToMove());
+    if (inCheck) ++depth;
+    if (depth <= 0) return quiescence(alpha, beta, ply);
+    countNode();
+
+    TTEntry entry{};
+    Move ttMove{};
+    if (tt.probe(board.hash(), entry)) {
+        ttMove = entry.move;
+        int score = scoreFromTT(entry.score, ply);
+        if (!rootNode && entry.depth >= depth
+            && (entry.bound == ExactBound
+                || (entry.bound == LowerBound && score >= beta)
+                || (entry.bound == UpperBound && score <= alpha))) {
+            return score;
+        }
+    }
+
+    MoveList moves;
+    board.generateLegalMoves(moves);
+    if (moves.empty()) return inCheck ? -MateScore + ply : 0;
+    Move previous = rootNode ? Move{} : playedMoves[ply - 1];
+    MovePicker picker(board, moves, ttMove, &ordering, ply, previous);
+    std::array<Move, MoveList::Capacity> quietsTried;
+    int quietCount = 0;
+
+    int originalAlpha = alpha;
+    int best = -InfiniteScore;
+    Move bestMove{};
+    for (Move move; picker.next(move);) {
+        playedMoves[ply] = move;
+        Undo undo = board.makeMove(move);
+        int score = -negamax(depth - 1, -beta, -alpha, ply + 1);
+        board.unmakeMove(move, undo);
+        if (isStopped()) return 0;
+
+        bool quiet = !move.isCapture() && !move.isPromotion();
+        if (score > best) {
+            best = score;
+            bestMove = move;
+            if (score > alpha) {
+                alpha = score;
+                updatePv(ply, move);
+                if (alpha >= beta) {
+                    if (quiet) ordering.updateQuiet(board, move, previous, ply, depth, {quietsTried.data(), static_cast<size_t>(quietCount)});
+                    break;
+                }
+            }
+        }
+        if (quiet) quietsTried[quietCount++] = move;
+    }
+
+    Bound bound = best >= beta ? LowerBound : (best > originalAlpha ? ExactBound : UpperBound);
+    tt.store(board.hash(), bestMove, scoreToTT(best, ply), 0, depth, bound);
+    return best;
+}
+
+int Search::quiescence(int alpha, int beta, int ply) {
+    pvTable[ply].length = 0;
+    if (shouldStop()) return 0;
+    countNode();
+
+    bool inCheck = board.isKingInCheck(board.sideToMove());
+    int best = -InfiniteScore;
+    if (!inCheck) {
+        best = evaluate(board, pawns);
+        if (best >= beta || ply >= MaxPly - 1) return best;
+        alpha = std::max(alpha, best);
+    }
+
+    MoveList moves;
+    board.generateLegalMoves(moves);
+    if (moves.empty()) return inCheck ? -MateScore + ply : best;
+    if (ply >= MaxPly - 1) return evaluate(board, pawns);
+
+    // Out of check only captures and queen promotions are searched; in check every evasion is.
+    if (!inCheck) {
+        int kept = 0;
+        for (Move move : moves) {
+            if (move.isCapture() || (move.isPromotion() && move.promotionType() == Queen)) moves[kept++] = move;
+        }
+        moves.resize(kept);
+    }
+    MovePicker picker(board, moves, Move{}, nullptr, ply, Move{});
+
+    for (Move move; picker.next(move);) {
+        Undo undo = board.makeMove(move);
+        int score = -quiescence(-beta, -alpha, ply + 1);
+        board.unmakeMove(move, undo);
+        if (isStopped()) return 0;
+
+        if (score > best) {
+            best = score;
+            if (score > alpha) {
+                alpha = score;
+                updatePv(ply, move);
+                if (alpha >= beta) break;
+            }
+        }
+    }
+    return best;
+}
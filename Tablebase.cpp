@@ -0,0 +1,544 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+#include "include/Attacks.h"
+#include "include/Board.h"
+#include "include/MappedFile.h"
+#include "include/Tablebase.h"
+
+namespace {
+    // Table bytes: 0 a draw, 1 + n mate in n plies (won for the side to move when n is odd).
+    constexpr uint8_t Draw = 0;
+    constexpr uint8_t Unknown = 254;
+    constexpr uint8_t Illegal = 255;
+
+    // File header: magic, man count, the men in index order, padding.
+    constexpr char Magic[4] = {'C', 'T', 'B', '1'};
+    constexpr size_t HeaderSize = 16;
+
+    // Indices handed to a worker at a time.
+    constexpr uint64_t ChunkSize = 4096;
+
+    // Order of the men within one side of a signature.
+    constexpr std::string_view Letters = "KQRBNP";
+
+    constexpr PieceType PromotionTypes[] = {Queen, Rook, Bishop, Knight};
+
+    int material(char letter) {
+        switch (letter) {
+            case 'Q': return 9;
+            case 'R': return 5;
+            case 'B':
+            case 'N': return 3;
+            case 'P': return 1;
+            default: return 0;
+        }
+    }
+
+    char letterOf(Piece piece) {
+        return pieceChar(makePiece(White, typeOf(piece)));
+    }
+
+    void sortSide(std::string &side) {
+        std::sort(side.begin(), side.end(), [](char a, char b) { return Letters.find(a) < Letters.find(b); });
+    }
+
+    // Stronger side first, ties broken alphabetically, so both colourings share one name.
+    std::string canonicalSignature(std::string white, std::string black, bool &flipped) {
+        sortSide(white);
+        sortSide(black);
+        int whiteMaterial = 0;
+        int blackMaterial = 0;
+        for (char letter : white) whiteMaterial += material(letter);
+        for (char letter : black) blackMaterial += material(letter);
+        flipped = whiteMaterial < blackMaterial || (whiteMaterial == blackMaterial && white > black);
+        return flipped ? black + white : white + black;
+    }
+
+    // The index has no en-passant square, so a double push facing an enemy pawn could not be
+    // answered correctly; such endings are refused.
+    bool pawnsOnBothSides(std::string_view white, std::string_view black) {
+        return white.find('P') != std::string_view::npos && black.find('P') != std::string_view::npos;
+    }
+
+    bool parseSignature(std::string_view signature, std::string &white, std::string &black) {
+        size_t second = signature.find('K', 1);
+        if (signature.empty() || signature[0] != 'K' || second == std::string_view::npos) return false;
+        white = signature.substr(0, second);
+        black = signature.substr(second);
+        for (char letter : signature.substr(1)) {
+            if (Letters.find(letter) == std::string_view::npos) return false;
+        }
+        return std::count(signature.begin(), signature.end(), 'K') == 2 && !pawnsOnBothSides(white, black)
+               && signature.size() >= 3 && static_cast<int>(signature.size()) <= MaxTablebasePieces;
+    }
+
+    // Slot order of a canonical signature: white king, white men, black king, black men.
+    struct Layout {
+        std::array<Piece, MaxTablebasePieces> pieces{};
+        int count = 0;
+        std::array<int, 2> kings{};
+
+        // Side to move, white king on files a-d, then 64 squares for each further man.
+        [[nodiscard]] uint64_t size() const { return uint64_t{1} << (6 * count); }
+    };
+
+    Layout layoutOf(std::string_view signature) {
+        Layout layout;
+        Color color = White;
+        for (size_t i = 0; i < signature.size(); ++i) {
+            if (i > 0 && signature[i] == 'K') color = Black;
+            Piece piece = pieceFromChar(color == White ? signature[i] : static_cast<char>(signature[i] - 'A' + 'a'));
+            if (typeOf(piece) == King) layout.kings[color] = layout.count;
+            layout.pieces[layout.count++] = piece;
+        }
+        return layout;
+    }
+
+    // A captured man has square NoSquare.
+    struct Position {
+        std::array<int, MaxTablebasePieces> squares{};
+        Color side = White;
+    };
+
+    uint64_t indexOf(const Layout &layout, const Position &position) {
+        int mirror = colOf(position.squares[0]) >= 4 ? 7 : 0;
+        int king = position.squares[0] ^ mirror;
+        uint64_t index = position.side * 32 + rowOf(king) * 4 + colOf(king);
+        for (int slot = 1; slot < layout.count; ++slot) index = index * 64 + (position.squares[slot] ^ mirror);
+        return index;
+    }
+
+    Position positionAt(const Layout &layout, uint64_t index) {
+        Position position;
+        for (int slot = layout.count - 1; slot >= 1; --slot) {
+            position.squares[slot] = static_cast<int>(index & 63);
+            index >>= 6;
+        }
+        position.squares[0] = squareOf(static_cast<int>((index & 31) >> 2), static_cast<int>(index & 3));
+        position.side = static_cast<Color>(index >> 5);
+        return position;
+    }
+
+    Bitboard occupancy(const Layout &layout, const Position &position, Color color) {
+        Bitboard occupied = 0;
+        for (int slot = 0; slot < layout.count; ++slot) {
+            if (position.squares[slot] != NoSquare && colorOf(layout.pieces[slot]) == color) occupied |= squareBB(position.squares[slot]);
+        }
+        return occupied;
+    }
+
+    Bitboard attacksFrom(Piece piece, int square, Bitboard occupied) {
+        switch (typeOf(piece)) {
+            case Pawn: return Attacks::pawn(colorOf(piece), square);
+            case Knight: return Attacks::knight(square);
+            case Bishop: return Attacks::bishop(square, occupied);
+            case Rook: return Attacks::rook(square, occupied);
+            case Queen: return Attacks::queen(square, occupied);
+            default: return Attacks::king(square);
+        }
+    }
+
+    bool isAttacked(const Layout &layout, const Position &position, int square, Color by, Bitboard occupied) {
+        for (int slot = 0; slot < layout.count; ++slot) {
+            int from = position.squares[slot];
+            if (from == NoSquare || colorOf(layout.pieces[slot]) != by) continue;
+            if (attacksFrom(layout.pieces[slot], from, occupied) & squareBB(square)) return true;
+        }
+        return false;
+    }
+
+    // Distinct squares, no pawn on a back rank, and the side that just moved not in check.
+    bool isValid(const Layout &layout, const Position &position) {
+        Bitboard occupied = 0;
+        for (int slot = 0; slot < layout.count; ++slot) {
+            int square = position.squares[slot];
+            if (occupied & squareBB(square)) return false;
+            if (typeOf(layout.pieces[slot]) == Pawn && (rowOf(square) == 0 || rowOf(square) == 7)) return false;
+            occupied |= squareBB(square);
+        }
+        Color waiting = opposite(position.side);
+        return !isAttacked(layout, position, position.squares[layout.kings[waiting]], position.side, occupied);
+    }
+
+    // visit(child, movedSlot, capturedSlot or -1, promotion or NoPieceType) for each legal move.
+    // There is no castling and no en passant in a table position. The same piece rules as Board's
+    // generator, built from the shared Attacks tables, but on the slot squares directly: setting up
+    // a Board for every index would cost far more than the move generation itself, and the
+    // retrograde passes need the unmoves below, which Board has no counterpart for.
+    template <typename Visit>
+    void forEachMove(const Layout &layout, const Position &position, Visit visit) {
+        Color us = position.side;
+        Color them = opposite(us);
+        Bitboard own = occupancy(layout, position, us);
+        Bitboard occupied = own | occupancy(layout, position, them);
+        for (int slot = 0; slot < layout.count; ++slot) {
+            Piece piece = layout.pieces[slot];
+            if (colorOf(piece) != us) continue;
+            int from = position.squares[slot];
+            Bitboard targets;
+            if (typeOf(piece) == Pawn) {
+                int forward = us == White ? 8 : -8;
+                targets = Attacks::pawn(us, from) & (occupied & ~own);
+                if (!(occupied & squareBB(from + forward))) {
+                    targets |= squareBB(from + forward);
+                    bool start = rowOf(from) == (us == White ? 1 : 6);
+                    if (start && !(occupied & squareBB(from + 2 * forward))) targets |= squareBB(from + 2 * forward);
+                }
+            } else {
+                targets = attacksFrom(piece, from, occupied) & ~own;
+            }
+
+            while (targets) {
+                int to = popLsb(targets);
+                Position child = position;
+                child.squares[slot] = to;
+                child.side = them;
+                int captured = -1;
+                for (int other = 0; other < layout.count; ++other) {
+                    if (other != slot && position.squares[other] == to) {
+                        captured = other;
+                        child.squares[other] = NoSquare;
+                    }
+                }
+                Bitboard after = (occupied & ~squareBB(from)) | squareBB(to);
+                if (isAttacked(layout, child, child.squares[layout.kings[us]], them, after)) continue;
+
+                if (typeOf(piece) == Pawn && (rowOf(to) == 0 || rowOf(to) == 7)) {
+                    for (PieceType promotion : PromotionTypes) visit(child, slot, captured, promotion);
+                } else {
+                    visit(child, slot, captured, NoPieceType);
+                }
+            }
+        }
+    }
+
+    // visit(parent) for each position, with the other side to move, that reaches this one by a
+    // move staying inside the table: no capture and no promotion. Parents may be illegal.
+    template <typename Visit>
+    void forEachUnmove(const Layout &layout, const Position &position, Visit visit) {
+        Color mover = opposite(position.side);
+        Bitboard occupied = occupancy(layout, position, White) | occupancy(layout, position, Black);
+        for (int slot = 0; slot < layout.count; ++slot) {
+            Piece piece = layout.pieces[slot];
+            if (colorOf(piece) != mover) continue;
+            int to = position.squares[slot];
+            Bitboard origins = 0;
+            if (typeOf(piece) == Pawn) {
+                int back = mover == White ? -8 : 8;
+                int one = to + back;
+                if (rowOf(one) >= 1 && rowOf(one) <= 6 && !(occupied & squareBB(one))) {
+                    origins |= squareBB(one);
+                    bool doublePush = rowOf(to) == (mover == White ? 3 : 4);
+                    if (doublePush && !(occupied & squareBB(one + back))) origins |= squareBB(one + back);
+                }
+            } else {
+                origins = attacksFrom(piece, to, occupied) & ~occupied;
+            }
+
+            while (origins) {
+                Position parent = position;
+                parent.squares[slot] = popLsb(origins);
+                parent.side = mover;
+                visit(parent);
+            }
+        }
+    }
+
+    template <typename Body>
+    void parallelFor(uint64_t size, int threads, Body body) {
+        std::atomic<uint64_t> next{0};
+        auto work = [&] {
+            for (uint64_t begin; (begin = next.fetch_add(ChunkSize)) < size;) {
+                uint64_t end = std::min(size, begin + ChunkSize);
+                for (uint64_t index = begin; index < end; ++index) body(index);
+            }
+        };
+        std::vector<std::thread> pool;
+        for (int i = 1; i < threads; ++i) pool.emplace_back(work);
+        work();
+        for (std::thread &thread : pool) thread.join();
+    }
+
+    // Retrograde analysis. A first pass scores mates, stalemates and every move leaving the table
+    // (through lookup) and counts each position's moves not yet known to lose. Pass n then walks
+    // back from the positions decided at n plies: their parents are won in n + 1 if they were
+    // lost, and lose one more option if they were won, being lost once none is left. Whatever is
+    // undecided at the end is a draw.
+    template <typename Lookup>
+    std::vector<uint8_t> retrograde(const Layout &layout, int threads, Lookup lookup) {
+        uint64_t size = layout.size();
+        std::vector<uint8_t> values(size, Unknown);
+        std::vector<uint8_t> counters(size, 0);
+        std::vector<uint8_t> winExits(size, 0);
+        std::vector<uint8_t> lossExits(size, 0);
+        std::atomic<int> highest{0};
+        auto raise = [&](int value) {
+            int current = highest.load(std::memory_order_relaxed);
+            while (value > current && !highest.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+        };
+
+        parallelFor(size, threads, [&](uint64_t index) {
+            Position position = positionAt(layout, index);
+            if (!isValid(layout, position)) {
+                values[index] = Illegal;
+                return;
+            }
+            int moves = 0;
+            int open = 0;
+            uint8_t winExit = 0;
+            uint8_t lossExit = 0;
+            forEachMove(layout, position, [&](const Position &child, int moved, int captured, PieceType promotion) {
+                ++moves;
+                if (captured < 0 && promotion == NoPieceType) {
+                    ++open;
+                    return;
+                }
+                std::array<Piece, MaxTablebasePieces> pieces;
+                std::array<int, MaxTablebasePieces> squares;
+                int count = 0;
+                for (int slot = 0; slot < layout.count; ++slot) {
+                    if (child.squares[slot] == NoSquare) continue;
+                    bool promoted = slot == moved && promotion != NoPieceType;
+                    pieces[count] = promoted ? makePiece(position.side, promotion) : layout.pieces[slot];
+                    squares[count++] = child.squares[slot];
+                }
+                uint8_t value = lookup(pieces.data(), squares.data(), count, child.side);
+                if (value == Draw || value >= Unknown) {
+                    ++open;
+                } else if ((value - 1) % 2 == 0) {
+                    // Winning exits stay open too: the position can never be lost.
+                    ++open;
+                    winExit = winExit ? std::min<uint8_t>(winExit, value + 1) : value + 1;
+                } else {
+                    lossExit = std::max<uint8_t>(lossExit, value + 1);
+                }
+            });
+
+            if (moves == 0) {
+                bool inCheck = isAttacked(layout, position, position.squares[layout.kings[position.side]], opposite(position.side),
+                                          occupancy(layout, position, White) | occupancy(layout, position, Black));
+                values[index] = inCheck ? 1 : Draw;
+            } else if (open == 0) {
+                values[index] = lossExit;
+            }
+            counters[index] = static_cast<uint8_t>(open);
+            winExits[index] = winExit;
+            lossExits[index] = lossExit;
+            raise(std::max({1, static_cast<int>(winExit), static_cast<int>(lossExit)}));
+        });
+
+        for (int value = 1; value <= highest.load() && value < Unknown - 1; ++value) {
+            parallelFor(size, threads, [&](uint64_t index) {
+                if (values[index] == Unknown && winExits[index] == value) values[index] = static_cast<uint8_t>(value);
+            });
+
+            bool lost = (value - 1) % 2 == 0;
+            parallelFor(size, threads, [&](uint64_t index) {
+                if (std::atomic_ref<uint8_t>(values[index]).load(std::memory_order_relaxed) != value) return;
+                forEachUnmove(layout, positionAt(layout, index), [&](const Position &parent) {
+                    uint64_t parentIndex = indexOf(layout, parent);
+                    std::atomic_ref<uint8_t> parentValue(values[parentIndex]);
+                    if (parentValue.load(std::memory_order_relaxed) != Unknown) return;
+                    uint8_t expected = Unknown;
+                    if (lost) {
+                        if (parentValue.compare_exchange_strong(expected, static_cast<uint8_t>(value + 1), std::memory_order_relaxed)) raise(value + 1);
+                    } else if (std::atomic_ref<uint8_t>(counters[parentIndex]).fetch_sub(1, std::memory_order_relaxed) == 1) {
+                        auto loss = static_cast<uint8_t>(std::max<int>(value + 1, lossExits[parentIndex]));
+                        if (parentValue.compare_exchange_strong(expected, loss, std::memory_order_relaxed)) raise(loss);
+                    }
+                });
+            });
+        }
+
+        for (uint8_t &value : values) {
+            if (value == Unknown) value = Draw;
+        }
+        return values;
+    }
+}
+
+struct Tablebases::Table {
+    Layout layout;
+    std::vector<uint8_t> owned;
+    MappedFile file;
+    const uint8_t *values = nullptr;
+};
+
+Tablebases::Tablebases() = default;
+
+Tablebases::~Tablebases() = default;
+
+uint8_t Tablebases::lookup(const Piece *pieces, const int *squares, int count, Color side) const {
+    if (count == 2) return Draw;
+    std::string white;
+    std::string black;
+    for (int i = 0; i < count; ++i) (colorOf(pieces[i]) == White ? white : black) += letterOf(pieces[i]);
+    bool flipped;
+    auto it = tables.find(canonicalSignature(white, black, flipped));
+    if (it == tables.end()) return Illegal;
+
+    const Table &table = *it->second;
+    Position position;
+    position.side = flipped ? opposite(side) : side;
+    std::array<bool, MaxTablebasePieces> used{};
+    for (int slot = 0; slot < table.layout.count; ++slot) {
+        for (int i = 0; i < count; ++i) {
+            Piece piece = flipped ? makePiece(opposite(colorOf(pieces[i])), typeOf(pieces[i])) : pieces[i];
+            if (used[i] || piece != table.layout.pieces[slot]) continue;
+            used[i] = true;
+            position.squares[slot] = flipped ? squares[i] ^ 56 : squares[i];
+            break;
+        }
+    }
+    return table.values[indexOf(table.layout, position)];
+}
+
+bool Tablebases::probe(const Board &board, TablebaseResult &result) const {
+    if (board.castlingRights() != NoCastling) return false;
+    int ep = board.enPassantSquare();
+    Color side = board.sideToMove();
+    if (ep != NoSquare && (Attacks::pawn(opposite(side), ep) & board.bitboards().of(side, Pawn))) return false;
+    Bitboard occupied = board.bitboards().occupied;
+    int count = popCount(occupied);
+    if (count > largest) return false;
+
+    std::array<Piece, MaxTablebasePieces> pieces;
+    std::array<int, MaxTablebasePieces> squares;
+    for (int i = 0; occupied; ++i) {
+        squares[i] = popLsb(occupied);
+        pieces[i] = board.mailbox()[squares[i]];
+    }
+    uint8_t value = lookup(pieces.data(), squares.data(), count, side);
+    if (value == Illegal) return false;
+    int plies = value - 1;
+    result = value == Draw ? TablebaseResult{0, 0} : TablebaseResult{plies % 2 ? 1 : -1, plies};
+    return true;
+}
+
+bool Tablebases::generate(std::string_view signature, int threads, const std::function<void(const TablebaseReport &)> &report) {
+    std::string white;
+    std::string black;
+    if (!parseSignature(signature, white, black)) return false;
+    bool flipped;
+    return build(canonicalSignature(white, black, flipped), std::max(1, threads), report);
+}
+
+bool Tablebases::build(const std::string &signature, int threads, const std::function<void(const TablebaseReport &)> &report) {
+    if (tables.count(signature)) return true;
+    Attacks::init();
+    Layout layout = layoutOf(signature);
+
+    // Every ending one capture or promotion away has to be known first.
+    for (int slot = 0; slot < layout.count; ++slot) {
+        PieceType type = typeOf(layout.pieces[slot]);
+        if (type == King) continue;
+        for (PieceType replacement : {NoPieceType, Queen, Rook, Bishop, Knight}) {
+            if (replacement != NoPieceType && type != Pawn) break;
+            std::string white;
+            std::string black;
+            for (int other = 0; other < layout.count; ++other) {
+                Piece piece = layout.pieces[other];
+                if (other == slot) {
+                    if (replacement == NoPieceType) continue;
+                    piece = makePiece(colorOf(piece), replacement);
+                }
+                (colorOf(piece) == White ? white : black) += letterOf(piece);
+            }
+            bool flipped;
+            std::string child = canonicalSignature(white, black, flipped);
+            if (child.size() > 2 && !build(child, threads, report)) return false;
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto table = std::make_unique<Table>();
+    table->layout = layout;
+    table->owned = retrograde(layout, threads, [this](const Piece *pieces, const int *squares, int count, Color side) {
+        return lookup(pieces, squares, count, side);
+    });
+    table->values = table->owned.data();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (report) {
+        int longest = 0;
+        for (uint8_t value : table->owned) {
+            if (value != Illegal) longest = std::max<int>(longest, value);
+        }
+        report({signature, layout.size(), HeaderSize + layout.size(), seconds, std::max(0, longest - 1)});
+    }
+    tables.emplace(signature, std::move(table));
+    largest = std::max(largest, layout.count);
+    return true;
+}
+
+bool Tablebases::save(std::string_view signature, const char *directory) const {
+    std::string white;
+    std::string black;
+    if (!parseSignature(signature, white, black)) return false;
+    bool flipped;
+    auto it = tables.find(canonicalSignature(white, black, flipped));
+    if (it == tables.end()) return false;
+
+    const Table &table = *it->second;
+    char header[HeaderSize] = {};
+    std::memcpy(header, Magic, sizeof(Magic));
+    header[4] = static_cast<char>(table.layout.count);
+    for (int slot = 0; slot < table.layout.count; ++slot) header[5 + slot] = static_cast<char>(table.layout.pieces[slot]);
+
+    std::ofstream out(std::filesystem::path(directory) / (it->first + ".ctb"), std::ios::binary);
+    out.write(header, HeaderSize);
+    out.write(reinterpret_cast<const char *>(table.values), static_cast<std::streamsize>(table.layout.size()));
+    return static_cast<bool>(out);
+}
+
+bool Tablebases::load(const char *directory) {
+    std::error_code error;
+    std::filesystem::directory_iterator files(directory, error);
+    if (error) return false;
+
+    for (const auto &file : files) {
+        if (file.path().extension() != ".ctb") continue;
+        auto table = std::make_unique<Table>();
+        if (!table->file.open(file.path().c_str())) continue;
+        std::string_view data = table->file.view();
+        if (data.size() < HeaderSize || std::memcmp(data.data(), Magic, sizeof(Magic)) != 0) continue;
+        int count = data[4];
+        if (count < 3 || count > MaxTablebasePieces) continue;
+
+        std::string white;
+        std::string black;
+        for (int slot = 0; slot < count; ++slot) {
+            auto piece = static_cast<Piece>(data[5 + slot]);
+            (colorOf(piece) == White ? white : black) += letterOf(piece);
+        }
+        if (pawnsOnBothSides(white, black)) continue;
+        bool flipped;
+        std::string signature = canonicalSignature(white, black, flipped);
+        table->layout = layoutOf(signature);
+        bool matches = !flipped && data.size() == HeaderSize + table->layout.size();
+        for (int slot = 0; matches && slot < count; ++slot) matches = table->layout.pieces[slot] == static_cast<Piece>(data[5 + slot]);
+        if (!matches) continue;
+
+        table->values = reinterpret_cast<const uint8_t *>(data.data()) + HeaderSize;
+        tables.insert_or_assign(signature, std::move(table));
+        largest = std::max(largest, count);
+    }
+    return true;
+}
+
+bool Tablebases::contains(std::string_view signature) const {
+    std::string white;
+    std::string black;
+    bool flipped;
+    return parseSignature(signature, white, black) && tables.count(canonicalSignature(white, black, flipped));
+}
+
+int Tablebases::maxPieces() const {
+    return largest;
+}
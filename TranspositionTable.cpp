@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <limits>
+#include <new>
+#include "include/TranspositionTable.h"
+
+namespace {
+    // data layout: move 0-15, score 16-31, eval 32-47, depth 48-55, bound 56-57, generation 58-63
+    constexpr uint64_t pack(Move move, int score, int eval, int depth, Bound bound, uint8_t generation) {
+        return static_cast<uint64_t>(move.raw())
+               | static_cast<uint64_t>(static_cast<uint16_t>(score)) << 16
+               | static_cast<uint64_t>(static_cast<uint16_t>(eval)) << 32
+               | static_cast<uint64_t>(static_cast<uint8_t>(depth)) << 48
+               | static_cast<uint64_t>(bound) << 56
+               | static_cast<uint64_t>(generation & 63) << 58;
+    }
+
+    constexpr int depthOf(uint64_t data) {
+        return static_cast<int8_t>(data >> 48);
+    }
+
+    constexpr Bound boundOf(uint64_t data) {
+        return static_cast<Bound>((data >> 56) & 3);
+    }
+
+    constexpr uint8_t generationOf(uint64_t data) {
+        return static_cast<uint8_t>(data >> 58);
+    }
+}
+
+TranspositionTable::TranspositionTable(size_t megabytes, ReplacementPolicy policy) : replacement(policy) {
+    resize(megabytes);
+}
+
+TranspositionTable::~TranspositionTable() {
+    ::operator delete[](buckets, std::align_val_t{alignof(Bucket)});
+}
+
+void TranspositionTable::resize(size_t megabytes) {
+    ::operator delete[](buckets, std::align_val_t{alignof(Bucket)});
+    bucketCount = std::max<size_t>(1, megabytes * 1024 * 1024 / sizeof(Bucket));
+    buckets = static_cast<Bucket *>(::operator new[](bucketCount * sizeof(Bucket), std::align_val_t{alignof(Bucket)}));
+    clear();
+}
+
+void TranspositionTable::clear() {
+    for (size_t i = 0; i < bucketCount; ++i) {
+        for (Slot &slot : buckets[i].slots) {
+            slot.check.store(0, std::memory_order_relaxed);
+            slot.data.store(0, std::memory_order_relaxed);
+        }
+    }
+    generation = 0;
+}
+
+void TranspositionTable::newSearch() {
+    generation = (generation + 1) & 63;
+}
+
+void TranspositionTable::setPolicy(ReplacementPolicy policy) {
+    replacement = policy;
+}
+
+TranspositionTable::Bucket &TranspositionTable::bucketFor(uint64_t key) const {
+    return buckets[static_cast<size_t>((static_cast<unsigned __int128>(key) * bucketCount) >> 64)];
+}
+
+void TranspositionTable::prefetch(uint64_t key) const {
+    __builtin_prefetch(&bucketFor(key));
+}
+
+bool TranspositionTable::probe(uint64_t key, TTEntry &entry) const {
+    for (const Slot &slot : bucketFor(key).slots) {
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        if ((slot.check.load(std::memory_order_relaxed) ^ data) != key || boundOf(data) == NoBound) continue;
+
+        entry.move = Move::fromRaw(static_cast<uint16_t>(data));
+        entry.score = static_cast<int16_t>(data >> 16);
+        entry.eval = static_cast<int16_t>(data >> 32);
+        entry.depth = static_cast<int8_t>(depthOf(data));
+        entry.bound = boundOf(data);
+        return true;
+    }
+    return false;
+}
+
+void TranspositionTable::store(uint64_t key, Move move, int score, int eval, int depth, Bound bound) {
+    // Extensions can carry a search past what the 8-bit field holds; wrapping would make the
+    // deepest entries look shallowest.
+    depth = std::clamp<int>(depth, std::numeric_limits<int8_t>::min(), std::numeric_limits<int8_t>::max());
+    Bucket &bucket = bucketFor(key);
+    Slot *victim = nullptr;
+    int victimWorth = 0;
+
+    for (Slot &slot : bucket.slots) {
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        if (boundOf(data) == NoBound || (slot.check.load(std::memory_order_relaxed) ^ data) == key) {
+            // Same position (or a free slot): keep the old best move if the new store has none.
+            if (move == Move{} && boundOf(data) != NoBound) move = Move::fromRaw(static_cast<uint16_t>(data));
+            victim = &slot;
+            break;
+        }
+
+        int worth = depthOf(data);
+        if (replacement == ReplacementPolicy::Aging) worth -= 8 * ((generation - generationOf(data)) & 63);
+        if (!victim || worth < victimWorth) {
+            victim = &slot;
+            victimWorth = worth;
+        }
+    }
+
+    if (replacement == ReplacementPolicy::AlwaysReplace && victim != nullptr) {
+        uint64_t data = victim->data.load(std::memory_order_relaxed);
+        if (boundOf(data) != NoBound && (victim->check.load(std::memory_order_relaxed) ^ data) != key) {
+            victim = &bucket.slots[key & (BucketSize - 1)];
+        }
+    } else if (replacement == ReplacementPolicy::DepthPreferred) {
+        uint64_t data = victim->data.load(std::memory_order_relaxed);
+        bool samePosition = (victim->check.load(std::memory_order_relaxed) ^ data) == key;
+        if (boundOf(data) != NoBound && depth < depthOf(data) && !(samePosition && bound == ExactBound)) return;
+    }
+
+    uint64_t data = pack(move, score, eval, depth, bound, generation);
+    victim->check.store(key ^ data, std::memory_order_relaxed);
+    victim->data.store(data, std::memory_order_relaxed);
+}
+
+int TranspositionTable::hashfull() const {
+    size_t sample = std::min<size_t>(bucketCount, 1000 / BucketSize + 1);
+    int used = 0;
+    for (size_t i = 0; i < sample; ++i) {
+        for (const Slot &slot : buckets[i].slots) {
+            uint64_t data = slot.data.load(std::memory_order_relaxed);
+            used += boundOf(data) != NoBound && generationOf(data) == generation;
+        }
+    }
+    return static_cast<int>(used * 1000 / (sample * BucketSize));
+}
+
+size_t TranspositionTable::entryCount() const {
+    return bucketCount * BucketSize;
+}
+
+ReplacementPolicy TranspositionTable::policy() const {
+    return replacement;
+}
@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+#include "include/Board.h"
+
+namespace {
+    // Development position: every piece type has a move to make and a square to return to.
+    constexpr std::string_view Opening = "r1bqk2r/pppp1ppp/2n2n2/2b1p3/2B1P3/2N2N2/PPPP1PPP/R1BQK2R w KQkq - 4 5";
+    // Lone kings plus one slider in a corner: every ray is open.
+    constexpr std::string_view Open = "4k3/8/8/8/8/8/8/Q3K3 w - - 0 1";
+
+    Board boardFrom(std::string_view fen) {
+        Board board;
+        board.fromFEN(fen);
+        return board;
+    }
+
+    // Plays a move and its reverse, so the board is the same at the start of every iteration.
+    void roundTrip(benchmark::State &state, int fromRow, int fromCol, int toRow, int toCol) {
+        Board board = boardFrom(Opening);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(board.movePiece(fromRow, fromCol, toRow, toCol));
+            benchmark::DoNotOptimize(board.movePiece(toRow, toCol, fromRow, fromCol));
+        }
+    }
+
+    void BM_MoveKnight(benchmark::State &state) { roundTrip(state, 2, 5, 4, 6); }
+    void BM_MoveBishop(benchmark::State &state) { roundTrip(state, 3, 2, 5, 4); }
+    void BM_MoveRook(benchmark::State &state) { roundTrip(state, 0, 7, 0, 5); }
+    void BM_MoveQueen(benchmark::State &state) { roundTrip(state, 0, 3, 1, 4); }
+    void BM_MoveKing(benchmark::State &state) { roundTrip(state, 0, 4, 0, 5); }
+
+    // Pawns cannot move back, so the pawn is put back with setPiece; both costs are included.
+    void BM_MovePawn(benchmark::State &state) {
+        Board board = boardFrom(Opening);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(board.movePiece(1, 3, 2, 3));
+            board.setPiece(2, 3, NoPiece);
+            board.setPiece(1, 3, WhitePawn);
+        }
+    }
+
+    void BM_GetPieceAt(benchmark::State &state) {
+        Board board = boardFrom(StartFEN);
+        int square = 0;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(board.getPieceAt(rowOf(square), colOf(square)));
+            square = (square + 1) & 63;
+        }
+    }
+
+    void BM_SetPieceAt(benchmark::State &state) {
+        Board board = boardFrom(Open);
+        for (auto _ : state) {
+            board.setPieceAt(3, 3, "white_knight");
+            board.setPieceAt(3, 3, "");
+        }
+    }
+
+    // state.range(0): 0 on the open board, 1 on the start position where the first square is taken.
+    template <bool (Board::*Valid)(int, int, int, int) const>
+    void BM_SliderValid(benchmark::State &state, int toRow, int toCol) {
+        Board board = boardFrom(state.range(0) ? StartFEN : Open);
+        for (auto _ : state) benchmark::DoNotOptimize((board.*Valid)(0, 0, toRow, toCol));
+    }
+
+    void BM_IsRookMoveValid(benchmark::State &state) { BM_SliderValid<&Board::isRookMoveValid>(state, 7, 0); }
+    void BM_IsBishopMoveValid(benchmark::State &state) { BM_SliderValid<&Board::isBishopMoveValid>(state, 7, 7); }
+    void BM_IsQueenMoveValid(benchmark::State &state) { BM_SliderValid<&Board::isQueenMoveValid>(state, 7, 7); }
+
+    void BM_Initialize(benchmark::State &state) {
+        for (auto _ : state) {
+            Board board;
+            board.initialize();
+            benchmark::DoNotOptimize(board);
+        }
+    }
+
+    void BM_CopyBoard(benchmark::State &state) {
+        Board board = boardFrom(Opening);
+        for (auto _ : state) {
+            Board copy = board;
+            benchmark::DoNotOptimize(copy);
+        }
+    }
+}
+
+BENCHMARK(BM_MovePawn);
+BENCHMARK(BM_MoveKnight);
+BENCHMARK(BM_MoveBishop);
+BENCHMARK(BM_MoveRook);
+BENCHMARK(BM_MoveQueen);
+BENCHMARK(BM_MoveKing);
+BENCHMARK(BM_GetPieceAt);
+BENCHMARK(BM_SetPieceAt);
+BENCHMARK(BM_IsRookMoveValid)->ArgName("blocked")->Arg(0)->Arg(1);
+BENCHMARK(BM_IsBishopMoveValid)->ArgName("blocked")->Arg(0)->Arg(1);
+BENCHMARK(BM_IsQueenMoveValid)->ArgName("blocked")->Arg(0)->Arg(1);
+BENCHMARK(BM_Initialize);
+BENCHMARK(BM_CopyBoard);
+
+BENCHMARK_MAIN();
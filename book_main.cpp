@@ -0,0 +1,93 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <string>
+#include "include/Book.h"
+#include "include/MappedFile.h"
+#include "include/Pgn.h"
+
+namespace {
+    constexpr int DefaultMaxPly = 24;
+    constexpr int ProbeRounds = 100000;
+
+    int build(const char *pgnPath, const char *bookPath, int maxPly) {
+        MappedFile file;
+        if (!file.open(pgnPath, true)) {
+            std::cerr << "cannot map " << pgnPath << "\n";
+            return 2;
+        }
+
+        std::map<std::pair<uint64_t, uint16_t>, uint32_t> counts;
+        PgnReader reader(file.view());
+        PgnGame game;
+        Board board;
+        uint64_t games = 0;
+        while (reader.next(game)) {
+            int ply = 0;
+            int plies = 0;
+            replayGame(game, board, plies, nullptr, [&](const Board &position, Move move) {
+                if (ply++ < maxPly) ++counts[{bookKey(position), encodeBookMove(move)}];
+            });
+            ++games;
+        }
+
+        std::vector<BookEntry> entries;
+        entries.reserve(counts.size());
+        for (const auto &[position, count] : counts)
+            entries.push_back({position.first, position.second, static_cast<uint16_t>(std::min<uint32_t>(count, UINT16_MAX)), 0});
+        if (!writeBook(bookPath, entries)) {
+            std::cerr << "cannot write " << bookPath << "\n";
+            return 2;
+        }
+        std::cout << "games " << games << "  entries " << entries.size() << "\n";
+        return 0;
+    }
+
+    int probe(const char *bookPath, const char *fen) {
+        OpeningBook book;
+        if (!book.open(bookPath)) {
+            std::cerr << "cannot open " << bookPath << "\n";
+            return 2;
+        }
+        Board board;
+        if (!board.fromFEN(fen ? std::string_view(fen) : StartFEN)) {
+            std::cerr << "bad FEN\n";
+            return 2;
+        }
+
+        std::array<BookMove, MoveList::Capacity> moves;
+        int found = book.probe(board, moves);
+        for (int i = 0; i < found; ++i) {
+            char text[6];
+            toUci(moves[i].move, text);
+            std::cout << text << " " << moves[i].weight << "\n";
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < ProbeRounds; ++i) book.probe(board, moves);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "entries " << book.size() << "  moves " << found
+                  << "  probe " << seconds * 1e6 / ProbeRounds << " us\n";
+        return 0;
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc >= 4 && !std::strcmp(argv[1], "build")) {
+        int maxPly = DefaultMaxPly;
+        for (int i = 4; i + 1 < argc; ++i)
+            if (!std::strcmp(argv[i], "--max-ply")) maxPly = std::stoi(argv[++i]);
+        return build(argv[2], argv[3], maxPly);
+    }
+    if (argc >= 3 && !std::strcmp(argv[1], "probe")) {
+        const char *fen = nullptr;
+        for (int i = 3; i + 1 < argc; ++i)
+            if (!std::strcmp(argv[i], "--fen")) fen = argv[++i];
+        return probe(argv[2], fen);
+    }
+    std::cout << "usage: chess_book build <games.pgn> <book.bin> [--max-ply N]\n"
+                 "       chess_book probe <book.bin> [--fen FEN]\n";
+    return 2;
+}
@@ -0,0 +1,78 @@
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "include/Evaluate.h"
+#include "include/Perft.h"
+
+namespace {
+    std::vector<Board> buildCorpus(size_t count) {
+        std::vector<Board> corpus;
+        uint64_t state = 0x9E3779B97F4A7C15ull;
+        while (corpus.size() < count) {
+            for (const PerftReference &reference : PerftReferences) {
+                Board board;
+                board.fromFEN(reference.fen);
+                for (int ply = 0; ply < 80 && corpus.size() < count; ++ply) {
+                    MoveList moves;
+                    board.generateLegalMoves(moves);
+                    if (moves.empty()) break;
+                    state ^= state << 13;
+                    state ^= state >> 7;
+                    state ^= state << 17;
+                    board.makeMove(moves[static_cast<int>(state % moves.size())]);
+                    corpus.push_back(board);
+                }
+            }
+        }
+        return corpus;
+    }
+
+    const char *kernelName(EvalKernel kernel) {
+        switch (kernel) {
+            case EvalKernel::Avx2: return "avx2";
+            case EvalKernel::Sse41: return "sse4.1";
+            default: return "scalar";
+        }
+    }
+}
+
+// Evaluations per second for each kernel the CPU supports; the checksums must be equal.
+int main(int argc, char **argv) {
+    size_t positions = 4096;
+    int rounds = 2000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!std::strcmp(argv[i], "--positions")) positions = std::stoul(argv[i + 1]);
+        else if (!std::strcmp(argv[i], "--rounds")) rounds = std::stoi(argv[i + 1]);
+    }
+
+    std::vector<Board> corpus = buildCorpus(positions);
+    std::cout << "positions " << corpus.size() << " x " << rounds << " rounds, active kernel "
+              << kernelName(activeEvalKernel()) << "\n";
+
+    int64_t reference = 0;
+    bool ok = true;
+    for (EvalKernel kernel : {EvalKernel::Scalar, EvalKernel::Sse41, EvalKernel::Avx2}) {
+        if (!evalKernelSupported(kernel)) {
+            std::cout << std::setw(8) << kernelName(kernel) << "  not supported\n";
+            continue;
+        }
+        int64_t checksum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < rounds; ++round) {
+            for (const Board &board : corpus) checksum += evaluate(board, kernel);
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (kernel == EvalKernel::Scalar) reference = checksum;
+        ok &= checksum == reference;
+
+        std::cout << std::setw(8) << kernelName(kernel)
+                  << std::fixed << std::setprecision(1)
+                  << "  " << std::setw(8) << corpus.size() * rounds / seconds / 1e6 << " Mevals/s"
+                  << "  " << std::setw(6) << seconds * 1e9 / (corpus.size() * rounds) << " ns/eval"
+                  << "  checksum " << checksum << (checksum == reference ? "" : "  MISMATCH") << "\n";
+    }
+    return ok ? 0 : 1;
+}
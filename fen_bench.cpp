@@ -0,0 +1,86 @@
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "include/Perft.h"
+
+namespace {
+    // Positions from random playouts of the perft reference set, so the corpus mixes openings,
+    // middlegames with castling rights and en passant squares, and sparse endgames.
+    std::vector<std::string> buildCorpus(size_t count) {
+        std::vector<std::string> corpus;
+        uint64_t state = 0x9E3779B97F4A7C15ull;
+        char fen[MaxFENLength];
+        while (corpus.size() < count) {
+            for (const PerftReference &reference : PerftReferences) {
+                Board board;
+                board.fromFEN(reference.fen);
+                for (int ply = 0; ply < 80 && corpus.size() < count; ++ply) {
+                    MoveList moves;
+                    board.generateLegalMoves(moves);
+                    if (moves.empty()) break;
+                    state ^= state << 13;
+                    state ^= state >> 7;
+                    state ^= state << 17;
+                    board.makeMove(moves[static_cast<int>(state % moves.size())]);
+                    board.toFEN(fen);
+                    corpus.emplace_back(fen);
+                }
+            }
+        }
+        return corpus;
+    }
+
+    double secondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+int main(int argc, char **argv) {
+    size_t positions = 10000;
+    int rounds = 100;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!std::strcmp(argv[i], "--positions")) positions = std::stoul(argv[i + 1]);
+        else if (!std::strcmp(argv[i], "--rounds")) rounds = std::stoi(argv[i + 1]);
+    }
+
+    std::vector<std::string> corpus = buildCorpus(positions);
+    std::vector<Board> boards(corpus.size());
+    uint64_t checksum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        for (size_t i = 0; i < corpus.size(); ++i) {
+            if (!boards[i].fromFEN(corpus[i])) {
+                std::cerr << "failed to parse " << corpus[i] << "\n";
+                return 1;
+            }
+            checksum += boards[i].hash();
+        }
+    }
+    double parseSeconds = secondsSince(start);
+
+    char fen[MaxFENLength];
+    start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        for (const Board &board : boards) checksum += board.toFEN(fen) + fen[0];
+    }
+    double writeSeconds = secondsSince(start);
+
+    for (size_t i = 0; i < corpus.size(); ++i) {
+        boards[i].toFEN(fen);
+        if (corpus[i] != fen) {
+            std::cerr << "round trip mismatch: " << corpus[i] << " -> " << fen << "\n";
+            return 1;
+        }
+    }
+
+    double total = static_cast<double>(corpus.size()) * rounds;
+    std::cout << "positions " << corpus.size() << " x " << rounds << " rounds (checksum " << std::hex << checksum << std::dec << ")\n"
+              << std::fixed << std::setprecision(0)
+              << "fromFEN " << std::setw(12) << total / parseSeconds << " FENs/s\n"
+              << "toFEN   " << std::setw(12) << total / writeSeconds << " FENs/s\n";
+    return 0;
+}
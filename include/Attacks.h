@@ -0,0 +1,99 @@
+#ifndef ATTACKS_H
+#define ATTACKS_H
+
+#include "Bitboards.h"
+
+#ifdef CHESS_USE_PEXT
+#include <immintrin.h>
+#endif
+
+// Precomputed attack tables. Leaper tables are constexpr; the sliding-piece
+// tables are built once by init() (safe to call from several threads) and
+// are read-only afterwards.
+namespace Attacks {
+
+    constexpr std::array<Bitboard, 64> leaperTable(const int (&deltas)[8][2]) {
+        std::array<Bitboard, 64> table{};
+        for (int square = 0; square < 64; ++square) {
+            for (const auto &delta : deltas) {
+                int row = rowOf(square) + delta[0];
+                int col = colOf(square) + delta[1];
+                if (row >= 0 && row < 8 && col >= 0 && col < 8) table[square] |= squareBB(squareOf(row, col));
+            }
+        }
+        return table;
+    }
+
+    constexpr int KnightDeltas[8][2] = {{2, 1}, {2, -1}, {-2, 1}, {-2, -1}, {1, 2}, {1, -2}, {-1, 2}, {-1, -2}};
+    constexpr int KingDeltas[8][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+
+    inline constexpr std::array<Bitboard, 64> KnightAttacks = leaperTable(KnightDeltas);
+    inline constexpr std::array<Bitboard, 64> KingAttacks = leaperTable(KingDeltas);
+
+    inline constexpr std::array<std::array<Bitboard, 64>, 2> PawnAttacks = [] {
+        std::array<std::array<Bitboard, 64>, 2> table{};
+        for (int square = 0; square < 64; ++square) {
+            table[White][square] = pawnAttacks(White, squareBB(square));
+            table[Black][square] = pawnAttacks(Black, squareBB(square));
+        }
+        return table;
+    }();
+
+    // Slider table entry. Builds with CHESS_USE_PEXT (the CHESS_PEXT CMake option) index the table
+    // with PEXT and leave magic unused; the choice is made at compile time so a lookup stays one
+    // inlined multiply or PEXT and a table read.
+    struct Magic {
+        Bitboard mask;
+        Bitboard magic;
+        Bitboard *attacks;
+        unsigned shift;
+
+        [[nodiscard]] unsigned index(Bitboard occupied) const {
+#ifdef CHESS_USE_PEXT
+            return static_cast<unsigned>(_pext_u64(occupied, mask));
+#else
+            return static_cast<unsigned>(((occupied & mask) * magic) >> shift);
+#endif
+        }
+    };
+
+#ifdef CHESS_USE_PEXT
+    constexpr bool UsePext = true;
+#else
+    constexpr bool UsePext = false;
+#endif
+
+    extern Magic RookMagics[64];
+    extern Magic BishopMagics[64];
+
+    void init();
+
+    inline Bitboard rook(int square, Bitboard occupied) {
+        const Magic &m = RookMagics[square];
+        return m.attacks[m.index(occupied)];
+    }
+
+    inline Bitboard bishop(int square, Bitboard occupied) {
+        const Magic &m = BishopMagics[square];
+        return m.attacks[m.index(occupied)];
+    }
+
+    inline Bitboard queen(int square, Bitboard occupied) {
+        return rook(square, occupied) | bishop(square, occupied);
+    }
+
+    constexpr Bitboard knight(int square) {
+        return KnightAttacks[square];
+    }
+
+    constexpr Bitboard king(int square) {
+        return KingAttacks[square];
+    }
+
+    // Squares a pawn of `color` standing on `square` attacks.
+    constexpr Bitboard pawn(Color color, int square) {
+        return PawnAttacks[color][square];
+    }
+}
+
+#endif
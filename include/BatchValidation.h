@@ -0,0 +1,14 @@
+#ifndef BATCH_VALIDATION_H
+#define BATCH_VALIDATION_H
+
+#include <cstdint>
+#include <span>
+#include "Board.h"
+
+// Checks each move against its position as Board::resolveMove would: only from/to are read, and
+// the side to move of the position must own the piece. Bit i of legal (word i / 64) is set when
+// moves[i] is legal. positions holds one entry per move, or a single position shared by all.
+// Returns false, writing nothing, if the span sizes do not fit.
+bool validateMoves(std::span<const CompactPosition> positions, std::span<const Move> moves, std::span<uint64_t> legal);
+
+#endif
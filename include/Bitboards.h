@@ -0,0 +1,100 @@
+#ifndef BITBOARDS_H
+#define BITBOARDS_H
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstdlib>
+#include "Piece.h"
+
+class Board;
+
+using Bitboard = uint64_t;
+
+constexpr Bitboard squareBB(int square) {
+    return Bitboard{1} << square;
+}
+
+constexpr int popCount(Bitboard bb) {
+    return std::popcount(bb);
+}
+
+constexpr int lsb(Bitboard bb) {
+    return std::countr_zero(bb);
+}
+
+constexpr int popLsb(Bitboard &bb) {
+    int square = lsb(bb);
+    bb &= bb - 1;
+    return square;
+}
+
+constexpr Bitboard FileA = 0x0101010101010101ULL;
+constexpr Bitboard FileH = FileA << 7;
+
+// Squares attacked by a set of pawns of the given color.
+constexpr Bitboard pawnAttacks(Color color, Bitboard pawns) {
+    if (color == White) return ((pawns << 7) & ~FileH) | ((pawns << 9) & ~FileA);
+    return ((pawns >> 9) & ~FileH) | ((pawns >> 7) & ~FileA);
+}
+
+// Squares strictly between two squares sharing a row, column or diagonal; empty otherwise.
+inline constexpr auto BetweenBB = [] {
+    std::array<std::array<Bitboard, 64>, 64> table{};
+    for (int from = 0; from < 64; ++from) {
+        for (int to = 0; to < 64; ++to) {
+            int rowDelta = rowOf(to) - rowOf(from);
+            int colDelta = colOf(to) - colOf(from);
+            bool aligned = rowDelta == 0 || colDelta == 0 || rowDelta == colDelta || rowDelta == -colDelta;
+            if (from == to || !aligned) continue;
+            int rowDir = (rowDelta > 0) - (rowDelta < 0);
+            int colDir = (colDelta > 0) - (colDelta < 0);
+            int row = rowOf(from) + rowDir;
+            int col = colOf(from) + colDir;
+            while (squareOf(row, col) != to) {
+                table[from][to] |= squareBB(squareOf(row, col));
+                row += rowDir;
+                col += colDir;
+            }
+        }
+    }
+    return table;
+}();
+
+// One mask per piece (indexed by the Piece code) plus per-color and total occupancy.
+struct Bitboards {
+    std::array<Bitboard, PieceCount> pieces{};
+    std::array<Bitboard, 2> byColor{};
+    Bitboard occupied = 0;
+
+    void add(Piece piece, int square) {
+        Bitboard bb = squareBB(square);
+        pieces[piece] |= bb;
+        byColor[colorOf(piece)] |= bb;
+        occupied |= bb;
+    }
+
+    void remove(Piece piece, int square) {
+        Bitboard bb = ~squareBB(square);
+        pieces[piece] &= bb;
+        byColor[colorOf(piece)] &= bb;
+        occupied &= bb;
+    }
+
+    [[nodiscard]] Bitboard of(Color color, PieceType type) const {
+        return pieces[makePiece(color, type)];
+    }
+
+    [[nodiscard]] Bitboard empty() const {
+        return ~occupied;
+    }
+
+    [[nodiscard]] Piece pieceOn(int square) const;
+
+    static Bitboards fromBoard(const Board &board);
+    [[nodiscard]] Board toBoard() const;
+
+    bool operator==(const Bitboards &) const = default;
+};
+
+#endif
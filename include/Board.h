@@ -1,30 +1,80 @@
 #ifndef BOARD_H
 #define BOARD_H
 
-#include <vector>
+#include <array>
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include "Bitboards.h"
+#include "Move.h"
+#include "Piece.h"
+
+namespace Nnue {
+    class Accumulator;
+}
+
+class Tablebases;
+struct TablebaseResult;
+
+enum CastlingRight : uint8_t {
+    NoCastling = 0,
+    WhiteKingSide = 1,
+    WhiteQueenSide = 2,
+    BlackKingSide = 4,
+    BlackQueenSide = 8,
+    AllCastling = 15
+};
+
+constexpr std::string_view StartFEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+// Longest FEN toFEN can produce, terminator included.
+constexpr int MaxFENLength = 96;
+
+// State makeMove cannot recover from the move itself.
+struct Undo {
+    Piece captured;
+    uint8_t castling;
+    int8_t epSquare;
+    uint16_t halfmoveClock;
+    uint16_t fullmoveNumber;
+    uint64_t hash;
+};
+
+// Position packed for bulk transfer: one nibble per square (square 2i in the low nibble of byte i)
+// plus the state move legality depends on. Move clocks are not kept.
+struct CompactPosition {
+    std::array<uint8_t, 32> squares;
+    uint8_t side;
+    uint8_t castling;
+    int8_t epSquare;
+    uint8_t reserved;
+};
 
 class Board {
 public:
     Board();
     void initialize();
 
-    void initializeRow(int row, const std::string &piece);
+    void initializeRow(int row, Piece piece);
+    void initializeRow(int row, std::string_view piece);
 
-    void initializePiece(int row, int col, const std::string &piece);
+    void initializePiece(int row, int col, Piece piece);
+    void initializePiece(int row, int col, std::string_view piece);
 
     [[nodiscard]] int getRows() const;
     [[nodiscard]] int getColumns() const;
     [[nodiscard]] std::string getPieceAt(int row, int col) const;
-    void setPieceAt(int row, int col, std::string piece);
+    void setPieceAt(int row, int col, std::string_view piece);
+    [[nodiscard]] Piece pieceAt(int row, int col) const;
+    void setPiece(int row, int col, Piece piece);
     bool movePiece(int startRow, int startCol, int endRow, int endCol);
-    bool movePawn(int startRow, int startCol, int endRow, int endCol, const std::string &piece);
-    bool moveRook(int startRow, int startCol, int endRow, int endCol, const std::string &piece);
-    bool moveBishop(int startRow, int startCol, int endRow, int endCol, const std::string &piece);
-    bool moveKnight(int startRow, int startCol, int endRow, int endCol, const std::string &piece);
-    bool moveQueen(int startRow, int startCol, int endRow, int endCol, const std::string &piece);
+    bool movePawn(int startRow, int startCol, int endRow, int endCol, Piece piece);
+    bool moveRook(int startRow, int startCol, int endRow, int endCol, Piece piece);
+    bool moveBishop(int startRow, int startCol, int endRow, int endCol, Piece piece);
+    bool moveKnight(int startRow, int startCol, int endRow, int endCol, Piece piece);
+    bool moveQueen(int startRow, int startCol, int endRow, int endCol, Piece piece);
 
-    bool moveKing(int startRow, int startCol, int endRow, int endCol, const std::string &piece);
+    bool moveKing(int startRow, int startCol, int endRow, int endCol, Piece piece);
 
     [[nodiscard]] bool isRookMoveValid(int startRow, int startCol, int endRow, int endCol) const;
     [[nodiscard]] bool isBishopMoveValid(int startRow, int startCol, int endRow, int endCol) const;
@@ -33,10 +83,91 @@ public:
 
     static bool isKingMoveValid(int startRow, int startCol, int endRow, int endCol);
 
+    // Accepts "white_king"/"black_king" (or just the color name); true if any king of that color is attacked.
     bool isKingInCheck(const std::string &king) const;
+    [[nodiscard]] bool isKingInCheck(Color color) const;
+    [[nodiscard]] bool isSquareAttacked(int square, Color by) const;
+    [[nodiscard]] Bitboard attackersTo(int square, Color by, Bitboard occupied) const;
+    [[nodiscard]] bool isLegal(Move move) const;
+
+    // Replaces the whole position; returns false (leaving the board untouched) on malformed input.
+    bool fromFEN(std::string_view fen);
+    // Writes the position as a NUL-terminated FEN into out (at least MaxFENLength bytes); returns its length.
+    int toFEN(char *out) const;
+
+    [[nodiscard]] CompactPosition compact() const;
+    // Replaces the whole position with clocks reset; returns false (board untouched) on invalid data.
+    bool fromCompact(const CompactPosition &position);
+
+    // The move movePiece(from, to) would play for the side to move (promoting to a queen), or
+    // Move{} if it would be refused. Never modifies the board.
+    [[nodiscard]] Move resolveMove(int from, int to) const;
+
+    // Legal moves for the side to move, built from the same per-piece rules as movePiece.
+    void generateLegalMoves(MoveList &moves) const;
+
+    // Plays a legal move (as produced by generateLegalMoves) in place; unmakeMove reverts it exactly.
+    Undo makeMove(Move move);
+    void unmakeMove(Move move, const Undo &undo);
+
+    [[nodiscard]] Color sideToMove() const;
+    void setSideToMove(Color color);
+    [[nodiscard]] uint8_t castlingRights() const;
+    [[nodiscard]] int enPassantSquare() const;
+    [[nodiscard]] int halfmoveClock() const;
+    [[nodiscard]] int fullmoveNumber() const;
+
+    [[nodiscard]] const Bitboards &bitboards() const;
+    // The 64 squares indexed by squareOf(row, col).
+    [[nodiscard]] const std::array<Piece, 64> &mailbox() const;
+
+    // Zobrist key of piece placement, side to move, castling rights and en-passant file,
+    // kept up to date incrementally by every board mutation.
+    [[nodiscard]] uint64_t hash() const;
+    // Zobrist key of the pawns alone, for caching pawn-structure evaluation.
+    [[nodiscard]] uint64_t pawnHash() const;
+
+    // Exact result from the endgame tables when they cover the position; see Tablebases::probe.
+    bool probeTablebase(const Tablebases &tables, TablebaseResult &result) const;
+
+    // Every later piece change (setPieceAt, makeMove, unmakeMove, ...) is forwarded to the
+    // accumulator as feature deltas; it is refreshed here. Copies of the board start detached.
+    void attachAccumulator(Nnue::Accumulator *accumulator);
+    [[nodiscard]] const Nnue::Accumulator *accumulator() const;
+
+    bool operator==(const Board &) const = default;
 
 private:
-    std::vector<std::vector<std::string>> grid;
+    bool moveToTarget(int startRow, int startCol, int endRow, int endCol, Piece piece);
+    bool playIfLegal(Move move);
+    void placePiece(int square, Piece piece);
+    [[nodiscard]] uint64_t computeHash() const;
+    [[nodiscard]] uint64_t computePawnHash() const;
+
+    [[nodiscard]] int pawnMoveFlag(int from, int to, Color color) const;
+    [[nodiscard]] int castleFlag(int from, int to, Color color) const;
+
+    void addPawnMoves(MoveList &moves, int from, int to, int flag) const;
+
+    std::array<Piece, 64> squares{};
+    Bitboards bb;
+    Color side = White;
+    uint8_t castling = NoCastling;
+    int8_t epSquare = NoSquare;
+    uint16_t halfmoves = 0;
+    uint16_t fullmoves = 1;
+    uint64_t key = 0;
+    uint64_t pawnKey = 0;
+
+    // Non-owning and not part of the position: never copied, always compares equal.
+    struct AccumulatorLink {
+        Nnue::Accumulator *target = nullptr;
+
+        AccumulatorLink() = default;
+        AccumulatorLink(const AccumulatorLink &) {}
+        AccumulatorLink &operator=(const AccumulatorLink &) { return *this; }
+        bool operator==(const AccumulatorLink &) const { return true; }
+    } link;
 };
 
 #endif
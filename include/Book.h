@@ -0,0 +1,59 @@
+#ifndef BOOK_H
+#define BOOK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "Board.h"
+#include "MappedFile.h"
+
+// One 16-byte record of a Polyglot .bin file, big-endian on disk, sorted by key.
+struct BookEntry {
+    uint64_t key;
+    uint16_t move;
+    uint16_t weight;
+    uint32_t learn;
+};
+
+struct BookMove {
+    Move move;
+    uint16_t weight;
+};
+
+// Polyglot move encoding: to file/row in bits 0-5, from file/row in bits 6-11, promotion
+// (1 knight .. 4 queen) in bits 12-14. Castling is written as the king taking its own rook.
+[[nodiscard]] uint16_t encodeBookMove(Move move);
+
+// Polyglot key of the position, so books written by other tools can be probed and ours read by them.
+[[nodiscard]] uint64_t bookKey(const Board &board);
+
+// Sorts the entries and writes them as a .bin file; returns false on I/O error.
+bool writeBook(const char *path, std::vector<BookEntry> &entries);
+
+// Read-only view of a book file. The file is mapped, never copied to the heap, so opening costs
+// nothing up front and processes probing the same book share its pages in the page cache.
+class OpeningBook {
+public:
+    bool open(const char *path);
+    void close();
+    [[nodiscard]] bool isOpen() const;
+    [[nodiscard]] size_t size() const;
+
+    // Writes the book moves for the position that are legal on it, heaviest first, and returns
+    // how many there were (at most out.size()).
+    int probe(const Board &board, std::span<BookMove> out) const;
+
+    // Weighted random choice among the book moves, random being any uniformly drawn number;
+    // Move{} when the position is not in the book.
+    [[nodiscard]] Move pick(const Board &board, uint64_t random) const;
+
+private:
+    [[nodiscard]] BookEntry entry(size_t index) const;
+
+    MappedFile file;
+    size_t count = 0;
+    bool opened = false;
+};
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef EVALUATE_H
+#define EVALUATE_H
+
+#include "Board.h"
+#include "PawnStructure.h"
+
+constexpr int PieceValues[7] = {0, 100, 320, 330, 500, 900, 0};
+
+// Implementations of the material + piece-square sum. All of them return identical scores;
+// evaluate() uses the widest one the CPU supports.
+enum class EvalKernel : uint8_t {
+    Scalar,
+    Sse41,
+    Avx2
+};
+
+// Material plus piece-square bonus of one piece, positive for White.
+[[nodiscard]] int pieceSquareScore(Piece piece, int square);
+
+[[nodiscard]] bool evalKernelSupported(EvalKernel kernel);
+[[nodiscard]] EvalKernel activeEvalKernel();
+
+// Static score in centipawns from the side to move's point of view: the network output when the
+// board has an accumulator attached, otherwise material, piece-square tables and pawn structure.
+int evaluate(const Board &board);
+// Same score with the pawn-structure terms taken from a cache.
+int evaluate(const Board &board, PawnHashTable &pawns);
+// Material and piece-square sum alone, from the side to move's point of view, computed by a
+// specific kernel; the kernel must be supported.
+int evaluate(const Board &board, EvalKernel kernel);
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include "Bitboards.h"
+
+#ifndef CHESS_INSTRUMENTATION
+#define CHESS_INSTRUMENTATION 0
+#endif
+
+// Opt-in counters on the movePiece rule paths, built with -DCHESS_INSTRUMENTATION=ON. Each thread
+// counts into its own block and snapshot() merges them. Compiled out, the hooks are empty inline
+// functions and every snapshot is zero.
+namespace Instrumentation {
+    constexpr bool Enabled = CHESS_INSTRUMENTATION;
+
+    enum CallType : uint8_t {
+        MovePawn,
+        MoveRook,
+        MoveBishop,
+        MoveKnight,
+        MoveQueen,
+        MoveKing,
+        CallTypeCount
+    };
+
+    enum PathType : uint8_t {
+        RookPath,
+        BishopPath,
+        PathTypeCount
+    };
+
+    struct CallStats {
+        uint64_t calls = 0;
+        uint64_t accepted = 0;
+        uint64_t rejected = 0;
+        uint64_t nanoseconds = 0;
+    };
+
+    // Squares strictly between the start and end of each validity check.
+    struct PathStats {
+        uint64_t checks = 0;
+        uint64_t squares = 0;
+    };
+
+    struct Snapshot {
+        std::array<CallStats, CallTypeCount> calls{};
+        std::array<PathStats, PathTypeCount> paths{};
+    };
+
+    // Totals since the last reset over every thread, including threads that have exited.
+    [[nodiscard]] Snapshot snapshot();
+    void reset();
+
+    [[nodiscard]] std::string toText(const Snapshot &snapshot);
+    [[nodiscard]] std::string toJson(const Snapshot &snapshot);
+
+    void recordCall(CallType type, bool accepted, uint64_t nanoseconds);
+    void recordPath(PathType type, int squares);
+
+    // Times one move* call: constructed on entry, with every return value passed through result().
+    class CallScope {
+    public:
+#if CHESS_INSTRUMENTATION
+        explicit CallScope(CallType callType) : type(callType), start(std::chrono::steady_clock::now()) {}
+
+        bool result(bool accepted) {
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+            recordCall(type, accepted, elapsed.count());
+            return accepted;
+        }
+
+    private:
+        CallType type;
+        std::chrono::steady_clock::time_point start;
+#else
+        explicit CallScope(CallType) {}
+
+        bool result(bool accepted) { return accepted; }
+#endif
+    };
+
+    inline void countPath(PathType type, int from, int to) {
+        if constexpr (Enabled) recordPath(type, popCount(BetweenBB[from][to]));
+    }
+}
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string_view>
+
+// Read-only memory mapping of a whole file. Pages are loaded on demand by the kernel, so even
+// multi-gigabyte files cost only address space until they are touched.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    // Returns false if the file cannot be opened or mapped; an empty file maps to an empty view.
+    bool open(const char *path, bool sequential = false);
+    void close();
+
+    // Drops the resident pages before offset so a single forward pass keeps a flat footprint.
+    void release(size_t offset);
+    // Drops the whole pages inside [begin, end), for readers that finish ranges out of order.
+    // Safe to call from several threads; pages read again later are simply faulted back in.
+    void release(size_t begin, size_t end) const;
+
+    [[nodiscard]] std::string_view view() const;
+    [[nodiscard]] size_t size() const;
+
+private:
+    const char *data = nullptr;
+    size_t length = 0;
+    size_t released = 0;
+};
+
+#endif
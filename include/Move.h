@@ -0,0 +1,95 @@
+#ifndef MOVE_H
+#define MOVE_H
+
+#include <array>
+#include <cstdint>
+#include "Piece.h"
+
+enum MoveFlag : uint16_t {
+    Quiet = 0,
+    DoublePush = 1,
+    KingCastle = 2,
+    QueenCastle = 3,
+    Capture = 4,
+    EnPassant = 5,
+    PromoteKnight = 8,
+    PromoteBishop = 9,
+    PromoteRook = 10,
+    PromoteQueen = 11,
+    PromoteKnightCapture = 12,
+    PromoteBishopCapture = 13,
+    PromoteRookCapture = 14,
+    PromoteQueenCapture = 15
+};
+
+// 16-bit move: bits 0-5 start square, bits 6-11 end square, bits 12-15 MoveFlag.
+// Trivially constructible so MoveList never zeroes its buffer; use Move{} for the null move.
+class Move {
+public:
+    constexpr Move() = default;
+
+    constexpr Move(int from, int to, int flag = Quiet)
+        : data(static_cast<uint16_t>(from | (to << 6) | (flag << 12))) {}
+
+    [[nodiscard]] constexpr int from() const { return data & 63; }
+    [[nodiscard]] constexpr int to() const { return (data >> 6) & 63; }
+    [[nodiscard]] constexpr int flag() const { return data >> 12; }
+    [[nodiscard]] constexpr bool isCapture() const { return flag() & Capture; }
+    [[nodiscard]] constexpr bool isPromotion() const { return flag() & PromoteKnight; }
+    [[nodiscard]] constexpr bool isCastle() const { return flag() == KingCastle || flag() == QueenCastle; }
+
+    [[nodiscard]] constexpr PieceType promotionType() const {
+        return static_cast<PieceType>(Knight + (flag() & 3));
+    }
+
+    [[nodiscard]] constexpr uint16_t raw() const { return data; }
+
+    static constexpr Move fromRaw(uint16_t raw) {
+        return Move(raw & 63, (raw >> 6) & 63, raw >> 12);
+    }
+
+    constexpr bool operator==(const Move &) const = default;
+
+private:
+    uint16_t data;
+};
+
+// Writes the move in coordinate notation ("e2e4", "e7e8q") plus a terminating NUL; returns the length.
+inline int toUci(Move move, char *out) {
+    out[0] = static_cast<char>('a' + colOf(move.from()));
+    out[1] = static_cast<char>('1' + rowOf(move.from()));
+    out[2] = static_cast<char>('a' + colOf(move.to()));
+    out[3] = static_cast<char>('1' + rowOf(move.to()));
+    int length = 4;
+    if (move.isPromotion()) out[length++] = pieceChar(makePiece(Black, move.promotionType()));
+    out[length] = '\0';
+    return length;
+}
+
+// Fixed-capacity move buffer meant to live on the stack; no position has more than 218 legal moves.
+class MoveList {
+public:
+    static constexpr int Capacity = 256;
+
+    void push(Move move) { moves[count++] = move; }
+    void clear() { count = 0; }
+
+    [[nodiscard]] int size() const { return count; }
+    [[nodiscard]] bool empty() const { return count == 0; }
+
+    Move &operator[](int i) { return moves[i]; }
+    const Move &operator[](int i) const { return moves[i]; }
+
+    Move *begin() { return moves.data(); }
+    Move *end() { return moves.data() + count; }
+    [[nodiscard]] const Move *begin() const { return moves.data(); }
+    [[nodiscard]] const Move *end() const { return moves.data() + count; }
+
+    void resize(int size) { count = size; }
+
+private:
+    std::array<Move, Capacity> moves;
+    int count = 0;
+};
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef MOVE_ORDERING_H
+#define MOVE_ORDERING_H
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include "Board.h"
+
+constexpr int MaxPly = 128;
+
+enum OrderingHeuristic : uint8_t {
+    MvvLvaOnly = 0,
+    UseKillers = 1,
+    UseHistory = 2,
+    UseCounterMoves = 4,
+    AllHeuristics = 7
+};
+
+// Quiet-move knowledge gathered from beta cutoffs: two killer slots per ply, butterfly history
+// indexed by side, from and to, and the refutation of each (piece, target square) reply.
+class MoveOrdering {
+public:
+    static constexpr int MaxHistoryScore = 16384;
+
+    // Forgets killers and halves history and counter-move confidence; call once per search.
+    void newSearch();
+    void clear();
+    void setHeuristics(uint8_t heuristics);
+    [[nodiscard]] uint8_t heuristics() const;
+
+    // The quiet move best caused a cutoff at ply; earlier quiets tried at that node lose history.
+    void updateQuiet(const Board &board, Move best, Move previous, int ply, int depth, std::span<const Move> triedQuiets);
+
+    [[nodiscard]] Move killer(int ply, int slot) const;
+    [[nodiscard]] Move counterMove(const Board &board, Move previous) const;
+    [[nodiscard]] int history(Color side, Move move) const;
+
+private:
+    void updateHistory(Color side, Move move, int bonus);
+
+    uint8_t enabled = AllHeuristics;
+    std::array<std::array<Move, 2>, MaxPly + 1> killers{};
+    std::array<std::array<std::array<int16_t, 64>, 64>, 2> butterfly{};
+    std::array<std::array<Move, 64>, PieceCount> counters{};
+};
+
+// Hands out the moves of a list best first, selecting one at a time: a node that cuts off after
+// the first few moves never pays for sorting the rest. Order: TT move, captures by MVV-LVA, queen
+// promotions, killers, counter-move, then quiets by history, under-promotions last.
+class MovePicker {
+public:
+    // ordering may be null (quiescence): captures and promotions are still ranked.
+    MovePicker(const Board &board, MoveList &moves, Move ttMove, const MoveOrdering *ordering, int ply, Move previous);
+
+    // Returns false once every move has been handed out.
+    bool next(Move &move);
+
+private:
+    MoveList &moves;
+    std::array<int, MoveList::Capacity> scores;
+    int current = 0;
+};
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef NNUE_H
+#define NNUE_H
+
+#include <cstdint>
+#include "Piece.h"
+
+class Board;
+
+// Small quantized network: 768 piece-square features per perspective feed a shared hidden layer
+// of Hidden int16 neurons, clipped to [0, QA], then one output neuron over both perspectives
+// (side to move first). The hidden layer is kept in an Accumulator updated by feature deltas.
+namespace Nnue {
+    constexpr int Features = 768;
+    constexpr int Hidden = 128;
+    constexpr int QA = 255;
+    constexpr int QB = 64;
+    constexpr int EvalScale = 400;
+
+    struct Network {
+        alignas(32) int16_t featureWeights[Features][Hidden];
+        alignas(32) int16_t featureBias[Hidden];
+        alignas(32) int16_t outputWeights[2][Hidden];
+        int32_t outputBias;
+    };
+
+    // Feature index of piece on square as seen by perspective: own pieces first, squares flipped
+    // vertically for Black so both sides share one set of weights.
+    constexpr int featureIndex(Color perspective, Piece piece, int square) {
+        int relativeSquare = perspective == White ? square : square ^ 56;
+        int side = colorOf(piece) == perspective ? 0 : 1;
+        return (side * 6 + typeOf(piece) - 1) * 64 + relativeSquare;
+    }
+
+    // File layout: "CNUE", uint32 version, uint32 Hidden, then the Network arrays in declaration
+    // order, little-endian. Both return false on I/O error or a header that does not match.
+    bool load(Network &network, const char *path);
+    bool save(const Network &network, const char *path);
+
+    class Accumulator {
+    public:
+        explicit Accumulator(const Network &network);
+
+        // Rebuilds both perspectives from every piece on the board.
+        void refresh(const Board &board);
+        // One feature column per perspective: cost is per changed square, independent of material.
+        void add(Piece piece, int square);
+        void remove(Piece piece, int square);
+
+        // Centipawns from the side to move's point of view.
+        [[nodiscard]] int evaluate(Color sideToMove) const;
+
+    private:
+        const Network *network;
+        alignas(32) int16_t values[2][Hidden];
+    };
+}
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef PARALLEL_SEARCH_H
+#define PARALLEL_SEARCH_H
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "Search.h"
+
+// Lazy SMP: every worker runs the full iterative-deepening search on its own copy of the
+// root and they cooperate only through the shared transposition table. Worker 0 owns the
+// limits and the iteration reports; when it finishes, the helpers are stopped.
+class ParallelSearch {
+public:
+    ParallelSearch(TranspositionTable &table, int threads);
+    ~ParallelSearch();
+
+    ParallelSearch(const ParallelSearch &) = delete;
+    ParallelSearch &operator=(const ParallelSearch &) = delete;
+
+    // Not allowed while a search is running.
+    void setThreads(int threads);
+    [[nodiscard]] int threads() const;
+
+    // Launches the workers and returns immediately; a stop() issued after start() is never lost.
+    void start(const Board &root, const SearchLimits &limits, std::span<const uint64_t> history = {});
+    // Joins the workers in index order and returns the deepest result from an iteration that ran to
+    // completion (worker 0 on ties, or when no worker finished one).
+    SearchResult wait();
+    SearchResult run(const Board &root, const SearchLimits &limits, std::span<const uint64_t> history = {});
+
+    void stop();
+    [[nodiscard]] bool searching() const;
+    [[nodiscard]] uint64_t nodeCount() const;
+
+    void onIteration(std::function<void(const SearchInfo &)> callback);
+    // Forwarded to every worker, each of which keeps its own accumulator; also kept across setThreads.
+    void setNetwork(const Nnue::Network *network);
+    // Shared by every worker; the tables must not change while a search runs.
+    void setTablebases(const Tablebases *tables);
+
+private:
+    TranspositionTable &tt;
+    std::atomic<bool> stopFlag{false};
+    std::vector<std::unique_ptr<Search>> workers;
+    std::vector<SearchResult> results;
+    std::vector<std::thread> running;
+    std::vector<uint64_t> historyCopy;
+    std::function<void(const SearchInfo &)> iterationCallback;
+    const Nnue::Network *network = nullptr;
+    const Tablebases *tablebases = nullptr;
+};
+
+#endif
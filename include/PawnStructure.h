@@ -0,0 +1,45 @@
+#ifndef PAWN_STRUCTURE_H
+#define PAWN_STRUCTURE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Board.h"
+
+constexpr int DoubledPawnPenalty = 10;
+constexpr int IsolatedPawnPenalty = 15;
+constexpr int BackwardPawnPenalty = 8;
+constexpr int PassedPawnBonus[8] = {0, 5, 10, 20, 35, 60, 100, 0};
+
+struct PawnEntry {
+    uint64_t key;
+    int16_t score;     // White's point of view
+    Bitboard passed;   // passed pawns of both colors
+};
+
+// Doubled, isolated, backward and passed pawn terms computed from the pawn bitboards alone.
+[[nodiscard]] PawnEntry evaluatePawns(const Board &board);
+
+// Direct-mapped cache of evaluatePawns keyed on Board::pawnHash(). Pawn structure changes on few
+// moves, so most search nodes find their entry. One table per thread: it is not synchronized.
+class PawnHashTable {
+public:
+    explicit PawnHashTable(size_t kilobytes = 512);
+
+    const PawnEntry &probe(const Board &board);
+    void clear();
+
+    [[nodiscard]] uint64_t probes() const;
+    [[nodiscard]] uint64_t hits() const;
+    // Permille of probes answered from the table since the last resetCounters().
+    [[nodiscard]] int hitRate() const;
+    void resetCounters();
+
+private:
+    std::vector<PawnEntry> entries;
+    size_t mask;
+    uint64_t probeCount = 0;
+    uint64_t hitCount = 0;
+};
+
+#endif
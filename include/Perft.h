@@ -0,0 +1,26 @@
+#ifndef PERFT_H
+#define PERFT_H
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include "Board.h"
+
+// Published leaf counts for the standard perft positions, indexed by depth - 1.
+struct PerftReference {
+    std::string_view name;
+    std::string_view fen;
+    std::array<uint64_t, 6> nodes;
+    int depths;
+};
+
+extern const std::array<PerftReference, 6> PerftReferences;
+
+// Counts leaf nodes of the legal move tree; the board is restored on return.
+uint64_t perft(Board &board, int depth);
+
+// Same count computed on several threads: the top plies are expanded into per-position tasks
+// that are dealt onto per-thread deques, and idle threads steal from the others.
+uint64_t parallelPerft(const Board &board, int depth, int threads);
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef PGN_H
+#define PGN_H
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <string_view>
+#include "Board.h"
+
+struct PgnTag {
+    std::string_view name;
+    std::string_view value;
+};
+
+// One game as views into the source text; nothing is copied, so the text must outlive it.
+struct PgnGame {
+    static constexpr int MaxTags = 32;
+
+    std::array<PgnTag, MaxTags> tags;
+    int tagCount = 0;
+    std::string_view movetext;
+
+    // Value of the named tag, or an empty view if the game does not have it.
+    [[nodiscard]] std::string_view tag(std::string_view name) const;
+};
+
+// Splits PGN text into games without allocating. Tag lines beyond MaxTags or that do not parse
+// are ignored; movetext runs until the next line starting with '[' outside a {comment}.
+class PgnReader {
+public:
+    explicit PgnReader(std::string_view text);
+
+    // Returns false once the input is exhausted.
+    bool next(PgnGame &game);
+    // Byte offset of the first character not yet consumed.
+    [[nodiscard]] size_t position() const;
+
+private:
+    std::string_view text;
+    size_t pos = 0;
+};
+
+// First offset at or after offset where a game's tag section starts (a '[' line that does not
+// follow another tag line), or text.size(). At offset 0 it is the first non-blank byte, where
+// PgnReader starts even a game without tags. Lets a file be split into chunks without reading it.
+size_t findGameStart(std::string_view text, size_t offset);
+
+// Resolves a SAN move ("Nbd7", "exd6", "e8=Q+", "O-O") against the legal moves of the board;
+// returns Move{} if it matches none or more than one of them.
+Move parseSan(const Board &board, std::string_view san);
+
+// Plays the movetext from the game's start position (its FEN tag or the standard one), skipping
+// move numbers, comments, variations, NAGs and the result. Returns false at the first token that
+// is not a legal move, which is then stored in failedToken if given; plies counts the moves
+// applied either way. onMove, if set, sees each position just before its move is played.
+bool replayGame(const PgnGame &game, Board &board, int &plies, std::string_view *failedToken = nullptr,
+                const std::function<void(const Board &, Move)> &onMove = {});
+
+#endif
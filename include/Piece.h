@@ -0,0 +1,92 @@
+#ifndef PIECE_H
+#define PIECE_H
+
+#include <cstdint>
+#include <string_view>
+
+enum Color : uint8_t {
+    White = 0,
+    Black = 1
+};
+
+enum PieceType : uint8_t {
+    NoPieceType = 0,
+    Pawn = 1,
+    Knight = 2,
+    Bishop = 3,
+    Rook = 4,
+    Queen = 5,
+    King = 6
+};
+
+// One byte per square: bit 3 is the color, bits 0-2 the piece type.
+enum Piece : uint8_t {
+    NoPiece = 0,
+    WhitePawn = 1, WhiteKnight, WhiteBishop, WhiteRook, WhiteQueen, WhiteKing,
+    BlackPawn = 9, BlackKnight, BlackBishop, BlackRook, BlackQueen, BlackKing
+};
+
+constexpr int PieceCount = 16;
+
+constexpr int NoSquare = -1;
+
+constexpr Piece makePiece(Color color, PieceType type) {
+    return static_cast<Piece>((color << 3) | type);
+}
+
+constexpr Color colorOf(Piece piece) {
+    return static_cast<Color>(piece >> 3);
+}
+
+constexpr PieceType typeOf(Piece piece) {
+    return static_cast<PieceType>(piece & 7);
+}
+
+constexpr Color opposite(Color color) {
+    return static_cast<Color>(color ^ 1);
+}
+
+constexpr int squareOf(int row, int col) {
+    return row * 8 + col;
+}
+
+constexpr int rowOf(int square) {
+    return square >> 3;
+}
+
+constexpr int colOf(int square) {
+    return square & 7;
+}
+
+// String names used by the public getPieceAt/setPieceAt API.
+constexpr std::string_view pieceName(Piece piece) {
+    constexpr std::string_view names[PieceCount] = {
+        "", "white_pawn", "white_knight", "white_bishop", "white_rook", "white_queen", "white_king", "",
+        "", "black_pawn", "black_knight", "black_bishop", "black_rook", "black_queen", "black_king", ""
+    };
+    return names[piece & 15];
+}
+
+constexpr Piece pieceFromName(std::string_view name) {
+    for (int i = 0; i < PieceCount; ++i) {
+        auto piece = static_cast<Piece>(i);
+        if (!name.empty() && pieceName(piece) == name) return piece;
+    }
+    return NoPiece;
+}
+
+// FEN letters: uppercase for white, lowercase for black.
+constexpr char pieceChar(Piece piece) {
+    constexpr char letters[PieceCount + 1] = " PNBRQK  pnbrqk ";
+    return letters[piece & 15];
+}
+
+constexpr Piece pieceFromChar(char c) {
+    for (int i = 0; i < PieceCount; ++i) {
+        auto piece = static_cast<Piece>(i);
+        if (c != ' ' && pieceChar(piece) == c) return piece;
+    }
+    return NoPiece;
+}
+
+#endif
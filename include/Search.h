@@ -0,0 +1,117 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <span>
+#include "Board.h"
+#include "MoveOrdering.h"
+#include "Nnue.h"
+#include "PawnStructure.h"
+#include "Tablebase.h"
+#include "TranspositionTable.h"
+
+constexpr int MateScore = 32000;
+constexpr int InfiniteScore = 32001;
+constexpr int MateInMaxPly = MateScore - MaxPly;
+
+// A zero value disables the corresponding limit.
+struct SearchLimits {
+    int depth = MaxPly - 1;
+    int64_t movetimeMs = 0;
+    uint64_t nodes = 0;
+};
+
+struct PrincipalVariation {
+    std::array<Move, MaxPly> moves;
+    int length = 0;
+};
+
+struct SearchInfo {
+    int depth;
+    int score;
+    uint64_t nodes;
+    int64_t timeMs;
+    uint64_t nps;
+    const PrincipalVariation &pv;
+};
+
+struct SearchResult {
+    Move bestMove{};
+    int score = 0;
+    int depth = 0;
+    uint64_t nodes = 0;
+    int64_t timeMs = 0;
+    uint64_t nps = 0;
+    PrincipalVariation pv;
+};
+
+// Iterative-deepening negamax alpha-beta with quiescence search. The root position is copied
+// once; the tree is then walked with makeMove/unmakeMove on that single board.
+class Search {
+public:
+    explicit Search(TranspositionTable &table);
+
+    // `history` holds the keys of the game positions before `root`, oldest first, for repetition detection.
+    SearchResult run(const Board &root, const SearchLimits &searchLimits, std::span<const uint64_t> history = {});
+
+    // Safe to call from another thread; the running search returns its last completed iteration.
+    void stop();
+
+    void onIteration(std::function<void(const SearchInfo &)> callback);
+
+    // Makes this search one worker of a parallel group: it obeys the group's stop flag, leaves
+    // TranspositionTable::newSearch to the group, and odd thread indices search one ply deeper.
+    void joinGroup(int index, std::atomic<bool> &groupStop);
+
+    [[nodiscard]] uint64_t nodeCount() const;
+
+    // Evaluates with this network, kept up to date incrementally along the tree; nullptr restores
+    // the material and piece-square evaluation. The network must outlive its use.
+    void setNetwork(const Nnue::Network *network);
+
+    // Positions the tables cover are scored exactly instead of searched; nullptr disables probing.
+    void setTablebases(const Tablebases *tables);
+
+    // Killer, history and counter-move tables; they persist across runs and are aged by each one.
+    [[nodiscard]] MoveOrdering &moveOrdering();
+    // Per-search pawn-structure cache; its counters cover every run since the last reset.
+    [[nodiscard]] PawnHashTable &pawnTable();
+
+private:
+    static constexpr int MaxHistory = 1024;
+
+    int negamax(int depth, int alpha, int beta, int ply);
+    int quiescence(int alpha, int beta, int ply);
+    bool shouldStop();
+    [[nodiscard]] bool isStopped() const;
+    void countNode();
+    [[nodiscard]] bool isRepetition(int ply) const;
+    [[nodiscard]] int64_t elapsedMs() const;
+    void updatePv(int ply, Move move);
+
+    TranspositionTable &tt;
+    Board board;
+    SearchLimits limits;
+    std::chrono::steady_clock::time_point startTime;
+    std::atomic<bool> ownStop{false};
+    std::atomic<bool> *stopFlag = &ownStop;
+    int threadIndex = 0;
+    bool limitsActive = false;
+    std::atomic<uint64_t> nodes{0};
+    int keyBase = 0;
+    std::array<uint64_t, MaxHistory + MaxPly> keys{};
+    std::array<PrincipalVariation, MaxPly + 1> pvTable;
+    std::function<void(const SearchInfo &)> iterationCallback;
+    std::optional<Nnue::Accumulator> accumulator;
+    MoveOrdering ordering;
+    PawnHashTable pawns;
+    const Tablebases *tablebases = nullptr;
+    std::array<Move, MaxPly + 1> playedMoves{};
+};
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef TABLEBASE_H
+#define TABLEBASE_H
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include "Piece.h"
+
+class Board;
+
+// Largest ending indexed; a 5-man table would take 1 GB.
+constexpr int MaxTablebasePieces = 4;
+
+// Exact outcome for the side to move under best play. The fifty-move rule is not considered.
+struct TablebaseResult {
+    int wdl;    // 1 win, 0 draw, -1 loss
+    int plies;  // plies to mate, 0 for a draw
+};
+
+struct TablebaseReport {
+    std::string signature;
+    uint64_t positions;
+    uint64_t bytes;
+    double seconds;
+    int longestMate;  // plies
+};
+
+// Win/draw/loss and distance-to-mate tables for endings of up to MaxTablebasePieces men, named by
+// material signature: "KQK", "KRKP" (white's men from the first K, black's from the second).
+// Either colouring of an ending is answered by the same table. A table holds one byte per
+// position, indexed by the men's squares and the side to move with the white king mirrored
+// onto files a-d. There is no en-passant square in that index, so endings with pawns on both
+// sides ("KPKP") are not supported.
+class Tablebases {
+public:
+    Tablebases();
+    ~Tablebases();
+
+    Tablebases(const Tablebases &) = delete;
+    Tablebases &operator=(const Tablebases &) = delete;
+
+    // Maps every .ctb file in the directory; returns false if it cannot be read.
+    bool load(const char *directory);
+
+    // Builds the table by parallel retrograde analysis, first building every ending it converts
+    // into by a capture or promotion. Tables already present are reused. report, if set, is called
+    // once for each table built. Returns false for a malformed or oversized signature, or one with
+    // pawns on both sides.
+    bool generate(std::string_view signature, int threads, const std::function<void(const TablebaseReport &)> &report = {});
+
+    // Writes the table as <directory>/<signature>.ctb.
+    bool save(std::string_view signature, const char *directory) const;
+
+    [[nodiscard]] bool contains(std::string_view signature) const;
+    // Most men in any loaded or generated table; 0 if there are none.
+    [[nodiscard]] int maxPieces() const;
+
+    // False if the position has castling rights, an en-passant capture or no table.
+    bool probe(const Board &board, TablebaseResult &result) const;
+
+private:
+    struct Table;
+
+    // Raw table byte for the men and side to move, whichever colouring the table is stored in.
+    [[nodiscard]] uint8_t lookup(const Piece *pieces, const int *squares, int count, Color side) const;
+    bool build(const std::string &signature, int threads, const std::function<void(const TablebaseReport &)> &report);
+
+    std::map<std::string, std::unique_ptr<Table>, std::less<>> tables;
+    int largest = 0;
+};
+
+#endif
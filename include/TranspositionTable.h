@@ -0,0 +1,77 @@
+#ifndef TRANSPOSITION_TABLE_H
+#define TRANSPOSITION_TABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "Move.h"
+
+enum Bound : uint8_t {
+    NoBound = 0,
+    UpperBound = 1,
+    LowerBound = 2,
+    ExactBound = 3
+};
+
+enum class ReplacementPolicy : uint8_t {
+    DepthPreferred, // keep the deepest entries; a shallower store into a full bucket is dropped
+    AlwaysReplace,  // newest store always wins
+    Aging           // replace the shallowest entry, treating entries from older searches as shallower
+};
+
+struct TTEntry {
+    Move move;
+    int16_t score;
+    int16_t eval;
+    int8_t depth;
+    Bound bound;
+};
+
+// Fixed-size hash table keyed on Board::hash(), shared by any number of threads without locks.
+// Each slot stores (key ^ data, data) in two relaxed atomics; a torn write fails the XOR check
+// and reads as a miss instead of returning another position's data.
+class TranspositionTable {
+public:
+    static constexpr int BucketSize = 4;
+
+    explicit TranspositionTable(size_t megabytes, ReplacementPolicy policy = ReplacementPolicy::Aging);
+    ~TranspositionTable();
+
+    TranspositionTable(const TranspositionTable &) = delete;
+    TranspositionTable &operator=(const TranspositionTable &) = delete;
+
+    // Not thread-safe: call only while no search is using the table.
+    void resize(size_t megabytes);
+    void clear();
+    void newSearch();
+    void setPolicy(ReplacementPolicy policy);
+
+    bool probe(uint64_t key, TTEntry &entry) const;
+    // Depths outside int8_t are stored clamped to its range.
+    void store(uint64_t key, Move move, int score, int eval, int depth, Bound bound);
+    void prefetch(uint64_t key) const;
+
+    // Permille of sampled slots written during the current search, as reported by UCI "hashfull".
+    [[nodiscard]] int hashfull() const;
+    [[nodiscard]] size_t entryCount() const;
+    [[nodiscard]] ReplacementPolicy policy() const;
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> check;
+        std::atomic<uint64_t> data;
+    };
+
+    struct alignas(64) Bucket {
+        Slot slots[BucketSize];
+    };
+
+    [[nodiscard]] Bucket &bucketFor(uint64_t key) const;
+
+    Bucket *buckets = nullptr;
+    size_t bucketCount = 0;
+    uint8_t generation = 0;
+    ReplacementPolicy replacement;
+};
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <array>
+#include <cstdint>
+#include "Piece.h"
+
+// Compile-time Zobrist keys. Entries for NoPiece (and the unused codes) are zero,
+// so XOR-ing the key of whatever occupied a square is always safe.
+namespace Zobrist {
+
+    struct Keys {
+        std::array<std::array<uint64_t, 64>, PieceCount> pieceSquare{};
+        std::array<uint64_t, 16> castling{};
+        std::array<uint64_t, 8> enPassantFile{};
+        uint64_t sideToMove = 0;
+    };
+
+    constexpr uint64_t splitMix(uint64_t &state) {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    inline constexpr Keys keys = [] {
+        Keys k;
+        uint64_t state = 0x1D8E4E27C47D124FULL;
+        for (int piece = 0; piece < PieceCount; ++piece) {
+            if (typeOf(static_cast<Piece>(piece)) == NoPieceType || typeOf(static_cast<Piece>(piece)) > King) continue;
+            for (auto &key : k.pieceSquare[piece]) key = splitMix(state);
+        }
+        for (auto &key : k.castling) key = splitMix(state);
+        k.castling[0] = 0;
+        for (auto &key : k.enPassantFile) key = splitMix(state);
+        k.sideToMove = splitMix(state);
+        return k;
+    }();
+
+    constexpr uint64_t piece(Piece piece, int square) {
+        return keys.pieceSquare[piece][square];
+    }
+
+    constexpr uint64_t castling(uint8_t rights) {
+        return keys.castling[rights];
+    }
+
+    constexpr uint64_t enPassant(int square) {
+        return square == NoSquare ? 0 : keys.enPassantFile[colOf(square)];
+    }
+
+    constexpr uint64_t sideToMove() {
+        return keys.sideToMove;
+    }
+}
+
+#endif
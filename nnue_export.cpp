@@ -0,0 +1,38 @@
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include "include/Evaluate.h"
+#include "include/Nnue.h"
+
+// Writes a network that reproduces the material and piece-square evaluation, as a starting
+// point for training and a known-good file for the loader. Hidden neuron t - 1 sums the own
+// pieces of type t in units of Divisor centipawns; the output takes us minus them.
+int main(int argc, char **argv) {
+    if (argc != 2) {
+        std::cout << "usage: chess_nnue_export <out.nnue>\n";
+        return 2;
+    }
+
+    constexpr int Divisor = 16;
+    constexpr int Bias = 64; // keeps the king's negative bonuses above the clipping floor
+
+    auto network = std::make_unique<Nnue::Network>();
+    for (PieceType type : {Pawn, Knight, Bishop, Rook, Queen, King}) {
+        int neuron = type - 1;
+        network->featureBias[neuron] = Bias;
+        for (int square = 0; square < 64; ++square) {
+            double score = pieceSquareScore(makePiece(White, type), square);
+            int feature = Nnue::featureIndex(White, makePiece(White, type), square);
+            network->featureWeights[feature][neuron] = static_cast<int16_t>(std::lround(score / Divisor));
+        }
+        int weight = static_cast<int>(std::lround(double(Divisor) * Nnue::QA * Nnue::QB / Nnue::EvalScale));
+        network->outputWeights[0][neuron] = static_cast<int16_t>(weight);
+        network->outputWeights[1][neuron] = static_cast<int16_t>(-weight);
+    }
+
+    if (!Nnue::save(*network, argv[1])) {
+        std::cerr << "cannot write " << argv[1] << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,56 @@
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "include/Perft.h"
+#include "include/Search.h"
+
+namespace {
+    struct Configuration {
+        const char *name;
+        uint8_t heuristics;
+    };
+
+    constexpr Configuration Configurations[] = {
+        {"mvv-lva", MvvLvaOnly},
+        {"+killers", UseKillers},
+        {"+history", UseKillers | UseHistory},
+        {"+countermoves", AllHeuristics},
+    };
+}
+
+// Fixed-depth searches of the perft positions with the quiet-move heuristics switched on one by
+// one. Fewer nodes to the same depth is the measure of better ordering.
+int main(int argc, char **argv) {
+    int depth = 7;
+    size_t hashMb = 16;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!std::strcmp(argv[i], "--depth")) depth = std::stoi(argv[i + 1]);
+        else if (!std::strcmp(argv[i], "--hash")) hashMb = std::stoul(argv[i + 1]);
+    }
+
+    TranspositionTable table(hashMb);
+    Search search(table);
+    uint64_t baseline = 0;
+    std::cout << "ordering             nodes     time ms    vs mvv-lva\n";
+    for (const Configuration &configuration : Configurations) {
+        search.moveOrdering().setHeuristics(configuration.heuristics);
+        uint64_t nodes = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (const PerftReference &reference : PerftReferences) {
+            Board board;
+            board.fromFEN(reference.fen);
+            table.clear();
+            search.moveOrdering().clear();
+            nodes += search.run(board, {depth, 0, 0}).nodes;
+        }
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+        if (!baseline) baseline = nodes;
+
+        std::cout << std::left << std::setw(14) << configuration.name << std::right
+                  << std::setw(12) << nodes << std::setw(12) << ms
+                  << std::setw(13) << std::fixed << std::setprecision(1) << 100.0 * nodes / baseline << "%\n";
+    }
+    return 0;
+}
@@ -0,0 +1,126 @@
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "include/Perft.h"
+
+namespace {
+    void printUsage() {
+        std::cout << "usage: chess_perft [--fen \"<fen>\"] [--depth N] [--divide] [--threads N]\n"
+                     "       chess_perft --check [--max-nodes N] [--threads N]\n";
+    }
+
+    const PerftReference *findReference(std::string_view fen) {
+        for (const PerftReference &reference : PerftReferences) {
+            if (reference.fen == fen) return &reference;
+        }
+        return nullptr;
+    }
+
+    double secondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Runs depths 1..maxDepth, printing nodes and nodes/second; returns false on a reference mismatch.
+    bool runDepths(Board &board, int maxDepth, int threads, const PerftReference *reference) {
+        bool ok = true;
+        for (int depth = 1; depth <= maxDepth; ++depth) {
+            auto start = std::chrono::steady_clock::now();
+            uint64_t nodes = threads > 1 ? parallelPerft(board, depth, threads) : perft(board, depth);
+            double seconds = secondsSince(start);
+
+            std::cout << "depth " << std::setw(2) << depth
+                      << "  nodes " << std::setw(12) << nodes
+                      << "  time " << std::fixed << std::setprecision(3) << seconds << "s"
+                      << "  nps " << std::setw(12) << static_cast<uint64_t>(seconds > 0 ? nodes / seconds : 0);
+            if (reference && depth <= reference->depths) {
+                bool match = reference->nodes[depth - 1] == nodes;
+                std::cout << (match ? "  ok" : "  MISMATCH (expected " + std::to_string(reference->nodes[depth - 1]) + ")");
+                ok &= match;
+            }
+            std::cout << "\n";
+        }
+        return ok;
+    }
+
+    void divide(Board &board, int depth) {
+        MoveList moves;
+        board.generateLegalMoves(moves);
+        uint64_t total = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (Move move : moves) {
+            Undo undo = board.makeMove(move);
+            uint64_t nodes = depth > 1 ? perft(board, depth - 1) : 1;
+            board.unmakeMove(move, undo);
+
+            char uci[6];
+            toUci(move, uci);
+            std::cout << uci << ": " << nodes << "\n";
+            total += nodes;
+        }
+        double seconds = secondsSince(start);
+        std::cout << "\nmoves " << moves.size() << "\nnodes " << total
+                  << "\nnps " << static_cast<uint64_t>(seconds > 0 ? total / seconds : 0) << "\n";
+    }
+
+    // Every reference position down to the deepest depth whose count fits the node budget.
+    bool checkReferences(uint64_t maxNodes, int threads) {
+        bool ok = true;
+        for (const PerftReference &reference : PerftReferences) {
+            int depth = 1;
+            while (depth < reference.depths && reference.nodes[depth] <= maxNodes) ++depth;
+
+            Board board;
+            board.fromFEN(reference.fen);
+            std::cout << reference.name << "\n";
+            ok &= runDepths(board, depth, threads, &reference);
+        }
+        std::cout << (ok ? "all reference counts match\n" : "reference mismatch\n");
+        return ok;
+    }
+}
+
+int main(int argc, char **argv) {
+    std::string fen(StartFEN);
+    int depth = 5;
+    bool divideMode = false;
+    bool check = false;
+    uint64_t maxNodes = 5000000;
+    int threads = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--fen") && i + 1 < argc) {
+            fen = argv[++i];
+        } else if (!std::strcmp(argv[i], "--depth") && i + 1 < argc) {
+            depth = std::stoi(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--divide")) {
+            divideMode = true;
+        } else if (!std::strcmp(argv[i], "--check")) {
+            check = true;
+        } else if (!std::strcmp(argv[i], "--max-nodes") && i + 1 < argc) {
+            maxNodes = std::stoull(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--threads") && i + 1 < argc) {
+            threads = std::stoi(argv[++i]);
+        } else {
+            printUsage();
+            return 2;
+        }
+    }
+
+    if (check) return checkReferences(maxNodes, threads) ? 0 : 1;
+
+    Board board;
+    if (fen == StartFEN) {
+        board.initialize();
+    } else if (!board.fromFEN(fen)) {
+        std::cerr << "invalid FEN: " << fen << "\n";
+        return 2;
+    }
+
+    if (divideMode) {
+        divide(board, depth);
+        return 0;
+    }
+    return runDepths(board, depth, threads, findReference(fen)) ? 0 : 1;
+}
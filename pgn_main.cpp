@@ -0,0 +1,64 @@
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include "include/MappedFile.h"
+#include "include/Pgn.h"
+
+namespace {
+    // Resident pages of the mapping are dropped every this many bytes of input.
+    constexpr size_t ReleaseInterval = 64 << 20;
+}
+
+int main(int argc, char **argv) {
+    const char *path = nullptr;
+    bool reportErrors = false;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--errors")) reportErrors = true;
+        else path = argv[i];
+    }
+    if (!path) {
+        std::cout << "usage: chess_pgn <file.pgn> [--errors]\n";
+        return 2;
+    }
+
+    MappedFile file;
+    if (!file.open(path, true)) {
+        std::cerr << "cannot map " << path << "\n";
+        return 2;
+    }
+
+    PgnReader reader(file.view());
+    PgnGame game;
+    Board board;
+    uint64_t games = 0;
+    uint64_t skipped = 0;
+    uint64_t moves = 0;
+    size_t nextRelease = ReleaseInterval;
+
+    auto start = std::chrono::steady_clock::now();
+    while (reader.next(game)) {
+        size_t offset = game.movetext.data() - file.view().data();
+        int plies = 0;
+        bool ok = replayGame(game, board, plies);
+        moves += plies;
+        if (ok) {
+            ++games;
+        } else {
+            ++skipped;
+            if (reportErrors) std::cerr << "skipped game " << games + skipped << " (byte " << offset << ", ply " << plies + 1 << ")\n";
+        }
+        if (reader.position() >= nextRelease) {
+            file.release(reader.position());
+            nextRelease = reader.position() + ReleaseInterval;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "games " << games << "  skipped " << skipped << "  moves " << moves
+              << "  time " << std::fixed << std::setprecision(3) << seconds << "s\n"
+              << std::setprecision(0)
+              << "games/s " << (seconds > 0 ? games / seconds : 0)
+              << "  moves/s " << (seconds > 0 ? moves / seconds : 0) << "\n";
+    return 0;
+}
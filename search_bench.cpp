@@ -0,0 +1,68 @@
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include "include/Search.h"
+
+namespace {
+    // Fixed positions searched to a fixed depth: the total node count is a signature of the
+    // search behaviour and the nodes/second figure tracks engine throughput between releases.
+    constexpr std::string_view BenchPositions[] = {
+        StartFEN,
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+        "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+        "r1bq1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N1PN2/PP1B1PPP/R2QKB1R w KQ - 0 8",
+        "8/8/3k4/8/3K4/3P4/8/8 w - - 0 1",
+    };
+}
+
+int main(int argc, char **argv) {
+    int depth = 7;
+    size_t hashMb = 16;
+    const char *networkPath = nullptr;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!std::strcmp(argv[i], "--depth")) depth = std::stoi(argv[i + 1]);
+        else if (!std::strcmp(argv[i], "--hash")) hashMb = std::stoul(argv[i + 1]);
+        else if (!std::strcmp(argv[i], "--nnue")) networkPath = argv[i + 1];
+    }
+
+    TranspositionTable table(hashMb);
+    Search search(table);
+    auto network = std::make_unique<Nnue::Network>();
+    if (networkPath) {
+        if (!Nnue::load(*network, networkPath)) {
+            std::cerr << "cannot load network " << networkPath << "\n";
+            return 2;
+        }
+        search.setNetwork(network.get());
+    }
+    uint64_t totalNodes = 0;
+    int64_t totalMs = 0;
+
+    for (std::string_view fen : BenchPositions) {
+        Board board;
+        board.fromFEN(fen);
+        table.clear();
+        SearchResult result = search.run(board, {depth, 0, 0});
+
+        char best[6];
+        toUci(result.bestMove, best);
+        std::cout << std::left << std::setw(80) << fen << std::right
+                  << "  best " << std::setw(5) << best
+                  << "  score " << std::setw(6) << result.score
+                  << "  nodes " << std::setw(10) << result.nodes
+                  << "  nps " << std::setw(9) << result.nps << "\n";
+        totalNodes += result.nodes;
+        totalMs += result.timeMs;
+    }
+
+    std::cout << "\ntotal nodes " << totalNodes << "\ntime ms     " << totalMs
+              << "\nnps         " << (totalMs > 0 ? totalNodes * 1000 / totalMs : totalNodes)
+              << "\npawn hash   " << search.pawnTable().hits() << " / " << search.pawnTable().probes()
+              << " hits (" << search.pawnTable().hitRate() / 10.0 << "%)\n";
+    return 0;
+}
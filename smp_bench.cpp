@@ -0,0 +1,52 @@
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "include/ParallelSearch.h"
+
+namespace {
+    constexpr std::string_view ScalingPositions[] = {
+        StartFEN,
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+        "r1bq1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N1PN2/PP1B1PPP/R2QKB1R w KQ - 0 8",
+    };
+}
+
+// Time-to-depth for 1, 2, 4, 8... threads; the speedup column is relative to one thread.
+int main(int argc, char **argv) {
+    int depth = 8;
+    size_t hashMb = 64;
+    int maxThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!std::strcmp(argv[i], "--depth")) depth = std::stoi(argv[i + 1]);
+        else if (!std::strcmp(argv[i], "--hash")) hashMb = std::stoul(argv[i + 1]);
+        else if (!std::strcmp(argv[i], "--threads")) maxThreads = std::stoi(argv[i + 1]);
+    }
+
+    TranspositionTable table(hashMb);
+    double baseline = 0;
+    std::cout << "threads   time-to-depth " << depth << "      nodes        nps   speedup\n";
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        ParallelSearch search(table, threads);
+        uint64_t nodes = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (std::string_view fen : ScalingPositions) {
+            Board board;
+            board.fromFEN(fen);
+            table.clear();
+            nodes += search.run(board, {depth, 0, 0}).nodes;
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (threads == 1) baseline = seconds;
+
+        std::cout << std::setw(7) << threads
+                  << std::setw(17) << std::fixed << std::setprecision(3) << seconds << "s"
+                  << std::setw(12) << nodes
+                  << std::setw(11) << static_cast<uint64_t>(nodes / seconds)
+                  << std::setw(9) << std::setprecision(2) << baseline / seconds << "x\n";
+    }
+    return 0;
+}
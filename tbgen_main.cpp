@@ -0,0 +1,49 @@
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "include/Tablebase.h"
+
+int main(int argc, char **argv) {
+    const char *directory = nullptr;
+    std::vector<std::string> signatures;
+    int threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--threads") && i + 1 < argc) threads = std::stoi(argv[++i]);
+        else if (!directory) directory = argv[i];
+        else signatures.emplace_back(argv[i]);
+    }
+    if (!directory || signatures.empty()) {
+        std::cout << "usage: chess_tbgen <directory> <signature>... [--threads N]\n"
+                     "       e.g. chess_tbgen tb KQK KRK KPK KRKP\n";
+        return 2;
+    }
+
+    Tablebases tables;
+    tables.load(directory);
+    std::vector<std::string> built;
+    auto report = [&](const TablebaseReport &table) {
+        built.push_back(table.signature);
+        std::cout << std::left << std::setw(6) << table.signature << std::right
+                  << "  positions " << std::setw(9) << table.positions
+                  << "  size " << std::setw(6) << (table.bytes + 1023) / 1024 << " KB"
+                  << "  time " << std::fixed << std::setprecision(2) << std::setw(6) << table.seconds << "s"
+                  << "  longest mate " << table.longestMate << " plies\n";
+    };
+    for (const std::string &signature : signatures) {
+        if (!tables.generate(signature, threads, report)) {
+            std::cerr << "bad signature " << signature << " (up to " << MaxTablebasePieces << " men, pawns on one side only, e.g. KRKP)\n";
+            return 2;
+        }
+    }
+    for (const std::string &signature : built) {
+        if (!tables.save(signature, directory)) {
+            std::cerr << "cannot write " << signature << " to " << directory << "\n";
+            return 2;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include "include/Attacks.h"
+
+namespace {
+    Bitboard walkRays(int square, Bitboard occupied, bool diagonal) {
+        Bitboard attacks = 0;
+        for (int rowDir = -1; rowDir <= 1; ++rowDir) {
+            for (int colDir = -1; colDir <= 1; ++colDir) {
+                if ((rowDir == 0 && colDir == 0) || ((rowDir != 0 && colDir != 0) != diagonal)) continue;
+                int row = rowOf(square) + rowDir;
+                int col = colOf(square) + colDir;
+                while (row >= 0 && row < 8 && col >= 0 && col < 8) {
+                    attacks |= squareBB(squareOf(row, col));
+                    if (occupied & squareBB(squareOf(row, col))) break;
+                    row += rowDir;
+                    col += colDir;
+                }
+            }
+        }
+        return attacks;
+    }
+}
+
+class AttacksTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Attacks::init();
+    }
+};
+
+TEST_F(AttacksTest, EmptyBoardRays) {
+    EXPECT_EQ(popCount(Attacks::rook(squareOf(0, 0), 0)), 14);
+    EXPECT_EQ(popCount(Attacks::bishop(squareOf(0, 0), 0)), 7);
+    EXPECT_EQ(popCount(Attacks::bishop(squareOf(3, 3), 0)), 13);
+    EXPECT_EQ(popCount(Attacks::queen(squareOf(3, 3), 0)), 27);
+}
+
+TEST_F(AttacksTest, BlockersStopRays) {
+    Bitboard occupied = squareBB(squareOf(0, 3)) | squareBB(squareOf(4, 0));
+    Bitboard expected = squareBB(squareOf(0, 1)) | squareBB(squareOf(0, 2)) | squareBB(squareOf(0, 3)) |
+                        squareBB(squareOf(1, 0)) | squareBB(squareOf(2, 0)) | squareBB(squareOf(3, 0)) |
+                        squareBB(squareOf(4, 0));
+    EXPECT_EQ(Attacks::rook(squareOf(0, 0), occupied), expected);
+}
+
+TEST_F(AttacksTest, MatchesRayWalkOnRandomOccupancies) {
+    uint64_t state = 0x2545F4914F6CDD1DULL;
+    for (int i = 0; i < 2000; ++i) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        Bitboard occupied = state & (state >> 3);
+        for (int square = 0; square < 64; ++square) {
+            ASSERT_EQ(Attacks::rook(square, occupied), walkRays(square, occupied, false));
+            ASSERT_EQ(Attacks::bishop(square, occupied), walkRays(square, occupied, true));
+        }
+    }
+}
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "include/BatchValidation.h"
+#include "include/Perft.h"
+
+TEST(BatchValidationTest, CompactRoundTrips) {
+    for (const PerftReference &reference : PerftReferences) {
+        Board board;
+        EXPECT_TRUE(board.fromFEN(reference.fen));
+        Board unpacked;
+        EXPECT_TRUE(unpacked.fromCompact(board.compact()));
+        EXPECT_EQ(unpacked.compact().squares, board.compact().squares);
+        EXPECT_EQ(unpacked.hash(), board.hash());
+    }
+
+    CompactPosition invalid = Board().compact();
+    invalid.squares[0] = 7;
+    Board board;
+    EXPECT_FALSE(board.fromCompact(invalid));
+}
+
+// Every (from, to) pair of every reference position must agree with movePiece on a copy.
+TEST(BatchValidationTest, MatchesMovePiece) {
+    std::vector<CompactPosition> positions;
+    std::vector<Move> moves;
+    std::vector<bool> expected;
+    int distinctLegal = 0;
+    for (const PerftReference &reference : PerftReferences) {
+        Board board;
+        EXPECT_TRUE(board.fromFEN(reference.fen));
+        MoveList legalMoves;
+        board.generateLegalMoves(legalMoves);
+        for (Move move : legalMoves) distinctLegal += !move.isPromotion() || move.promotionType() == Queen;
+        for (int from = 0; from < 64; ++from) {
+            for (int to = 0; to < 64; ++to) {
+                Board copy = board;
+                Piece piece = board.pieceAt(rowOf(from), colOf(from));
+                bool legal = piece != NoPiece && colorOf(piece) == board.sideToMove()
+                             && copy.movePiece(rowOf(from), colOf(from), rowOf(to), colOf(to));
+                positions.push_back(board.compact());
+                moves.emplace_back(from, to);
+                expected.push_back(legal);
+                EXPECT_EQ(board.resolveMove(from, to) != Move{}, legal);
+            }
+        }
+    }
+
+    std::vector<uint64_t> legal((moves.size() + 63) / 64);
+    ASSERT_TRUE(validateMoves(positions, moves, legal));
+    int count = 0;
+    for (size_t i = 0; i < moves.size(); ++i) {
+        bool bit = (legal[i / 64] >> (i % 64)) & 1;
+        EXPECT_EQ(bit, expected[i]) << i;
+        count += bit;
+    }
+    EXPECT_EQ(count, distinctLegal);
+
+    Board start;
+    start.initialize();
+    CompactPosition shared[] = {start.compact()};
+    std::span<const Move> firstPosition(moves.data(), 64 * 64);
+    ASSERT_TRUE(validateMoves(shared, firstPosition, legal));
+    int startMoves = 0;
+    for (int word = 0; word < 64; ++word) startMoves += popCount(legal[word]);
+    EXPECT_EQ(startMoves, 20);
+    EXPECT_FALSE(validateMoves(positions, firstPosition, legal));
+}
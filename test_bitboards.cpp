@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include "include/Board.h"
+
+class BitboardsTest : public ::testing::Test {
+protected:
+    Board board;
+
+    void SetUp() override {
+        board.initialize();
+    }
+
+    void expectInSync() const {
+        EXPECT_EQ(Bitboards::fromBoard(board), board.bitboards());
+    }
+};
+
+TEST_F(BitboardsTest, InitialOccupancy) {
+    const Bitboards &bb = board.bitboards();
+    EXPECT_EQ(popCount(bb.occupied), 32);
+    EXPECT_EQ(popCount(bb.byColor[White]), 16);
+    EXPECT_EQ(popCount(bb.byColor[Black]), 16);
+    EXPECT_EQ(bb.of(White, Pawn), 0x000000000000FF00ULL);
+    EXPECT_EQ(bb.of(Black, Pawn), 0x00FF000000000000ULL);
+    EXPECT_EQ(bb.of(White, King), squareBB(squareOf(0, 4)));
+    EXPECT_EQ(bb.of(Black, Queen), squareBB(squareOf(7, 3)));
+    expectInSync();
+}
+
+TEST_F(BitboardsTest, StaysInSyncAfterMovesAndEdits) {
+    board.setPieceAt(5, 1, "white_pawn");
+    EXPECT_TRUE(board.movePiece(6, 0, 5, 1));
+    expectInSync();
+
+    board.setPieceAt(2, 2, "white_rook");
+    EXPECT_TRUE(board.movePiece(2, 2, 2, 7));
+    expectInSync();
+
+    board.setPieceAt(6, 2, "black_pawn");
+    board.setPieceAt(4, 1, "white_pawn");
+    EXPECT_TRUE(board.movePiece(6, 2, 4, 2));
+    EXPECT_TRUE(board.movePiece(4, 1, 5, 2));
+    expectInSync();
+
+    board.setPieceAt(0, 4, "");
+    expectInSync();
+    EXPECT_EQ(board.bitboards().of(White, King), 0ULL);
+}
+
+TEST_F(BitboardsTest, RoundTripsThroughBoard) {
+    board.setPieceAt(4, 4, "black_knight");
+    Board copy = board.bitboards().toBoard();
+    for (int row = 0; row < 8; ++row) {
+        for (int col = 0; col < 8; ++col) {
+            EXPECT_EQ(copy.getPieceAt(row, col), board.getPieceAt(row, col));
+        }
+    }
+    EXPECT_EQ(copy.bitboards(), board.bitboards());
+}
+
+TEST(BetweenBBTest, CoversOnlyAlignedSquares) {
+    EXPECT_EQ(BetweenBB[squareOf(0, 0)][squareOf(0, 3)], squareBB(squareOf(0, 1)) | squareBB(squareOf(0, 2)));
+    EXPECT_EQ(BetweenBB[squareOf(2, 2)][squareOf(5, 5)], squareBB(squareOf(3, 3)) | squareBB(squareOf(4, 4)));
+    EXPECT_EQ(BetweenBB[squareOf(5, 0)][squareOf(3, 2)], squareBB(squareOf(4, 1)));
+    EXPECT_EQ(BetweenBB[squareOf(2, 2)][squareOf(4, 3)], 0ULL);
+    EXPECT_EQ(BetweenBB[squareOf(2, 2)][squareOf(3, 3)], 0ULL);
+}
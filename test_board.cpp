@@ -61,6 +61,28 @@ TEST_F(BoardTest, InitializesPiecesCorrectly) {
     }
 }
 
+TEST_F(BoardTest, PieceEncodingMatchesStringApi) {
+    EXPECT_EQ(board.pieceAt(0, 4), WhiteKing);
+    EXPECT_EQ(board.pieceAt(7, 3), BlackQueen);
+    EXPECT_EQ(board.pieceAt(3, 3), NoPiece);
+
+    board.setPiece(3, 3, BlackKnight);
+    expectPieceAt(3, 3, "black_knight");
+
+    board.setPieceAt(3, 3, "white_bishop");
+    EXPECT_EQ(board.pieceAt(3, 3), WhiteBishop);
+    EXPECT_EQ(colorOf(board.pieceAt(3, 3)), White);
+    EXPECT_EQ(typeOf(board.pieceAt(3, 3)), Bishop);
+
+    board.setPieceAt(3, 3, "");
+    expectEmptyAt(3, 3);
+
+    board.initializeRow(3, std::string("black_rook"));
+    expectPieceAt(3, 7, "black_rook");
+    board.initializePiece(3, 0, "white_queen");
+    EXPECT_EQ(board.pieceAt(3, 0), WhiteQueen);
+}
+
 TEST_F(BoardTest, WhitePawnStandardMove) {
     expectMovePiece(1, 0, 2, 0, true);
     expectPieceAt(2, 0, "white_pawn");
@@ -167,6 +189,7 @@ TEST_F(BoardTest, BlackPawnEnPassantCaptureSideTwo) {
 
 TEST_F(BoardTest, WhitePawnPromotion) {
     board.setPieceAt(6, 0, "white_pawn");
+    board.setPieceAt(7, 0, "");
     expectMovePiece(6, 0, 7, 0, true);
     EXPECT_TRUE(board.getPieceAt(7, 0) == "white_queen" || board.getPieceAt(7, 0) == "white_rook" ||
                 board.getPieceAt(7, 0) == "white_bishop" || board.getPieceAt(7, 0) == "white_knight");
@@ -175,12 +198,50 @@ TEST_F(BoardTest, WhitePawnPromotion) {
 
 TEST_F(BoardTest, BlackPawnPromotion) {
     board.setPieceAt(1, 0, "black_pawn");
+    board.setPieceAt(0, 0, "");
     expectMovePiece(1, 0, 0, 0, true);
     EXPECT_TRUE(board.getPieceAt(0, 0) == "black_queen" || board.getPieceAt(0, 0) == "black_rook" ||
                 board.getPieceAt(0, 0) == "black_bishop" || board.getPieceAt(0, 0) == "black_knight");
     expectEmptyAt(1, 0);
 }
 
+TEST_F(BoardTest, PawnPromotionBlockedStraightAhead) {
+    board.setPieceAt(6, 0, "white_pawn");
+    expectMovePiece(6, 0, 7, 0, false);
+    expectPieceAt(7, 0, "black_rook");
+
+    expectMovePiece(6, 0, 7, 1, true);
+    expectPieceAt(7, 1, "white_queen");
+}
+
+TEST_F(BoardTest, EnPassantOnlyRightAfterDoublePush) {
+    board.setPieceAt(4, 1, "white_pawn");
+    board.setPieceAt(4, 2, "black_pawn");
+    expectMovePiece(4, 1, 5, 2, false);
+    expectPieceAt(4, 2, "black_pawn");
+}
+
+TEST_F(BoardTest, WhiteKingCastles) {
+    board.setPieceAt(0, 5, "");
+    board.setPieceAt(0, 6, "");
+    expectMovePiece(0, 4, 0, 6, true);
+    expectPieceAt(0, 6, "white_king");
+    expectPieceAt(0, 5, "white_rook");
+    expectEmptyAt(0, 7);
+    EXPECT_EQ(board.castlingRights() & (WhiteKingSide | WhiteQueenSide), 0);
+}
+
+TEST_F(BoardTest, CastlingThroughAttackedSquareIsRefused) {
+    board.setPieceAt(0, 1, "");
+    board.setPieceAt(0, 2, "");
+    board.setPieceAt(0, 3, "");
+    board.setPieceAt(1, 3, "");
+    board.setPieceAt(4, 3, "black_rook");
+    expectMovePiece(0, 4, 0, 2, false);
+    expectPieceAt(0, 4, "white_king");
+    expectPieceAt(0, 0, "white_rook");
+}
+
 TEST_F(BoardTest, WhiteRookValidMoves) {
     board.setPieceAt(2, 2, "white_rook");
     expectMovePiece(2, 2, 4, 2, true);
@@ -472,17 +533,49 @@ TEST_F(BoardTest, WhiteKingValidMoves) {
     expectPieceAt(4, 5, "white_king");
     expectEmptyAt(4, 4);
 
-    expectMovePiece(4, 5, 5, 5, true);
-    expectPieceAt(5, 5, "white_king");
+    // Row 5 is covered by the black pawns, so walk the square on rows 3-4.
+    expectMovePiece(4, 5, 3, 5, true);
+    expectPieceAt(3, 5, "white_king");
     expectEmptyAt(4, 5);
 
-    expectMovePiece(5, 5, 5, 4, true);
-    expectPieceAt(5, 4, "white_king");
-    expectEmptyAt(5, 5);
+    expectMovePiece(3, 5, 3, 4, true);
+    expectPieceAt(3, 4, "white_king");
+    expectEmptyAt(3, 5);
 
-    expectMovePiece(5, 4, 4, 4, true);
+    expectMovePiece(3, 4, 4, 4, true);
     expectPieceAt(4, 4, "white_king");
-    expectEmptyAt(5, 4);
+    expectEmptyAt(3, 4);
+}
+
+TEST_F(BoardTest, WhiteKingCannotStepNextToPawns) {
+    board.setPieceAt(4, 4, "white_king");
+    expectMovePiece(4, 4, 5, 5, false);
+    expectPieceAt(4, 4, "white_king");
+}
+
+TEST_F(BoardTest, PinnedPieceCannotMove) {
+    board.setPieceAt(1, 4, "");
+    board.setPieceAt(2, 4, "white_bishop");
+    board.setPieceAt(4, 4, "black_rook");
+    expectMovePiece(2, 4, 3, 3, false);
+    expectPieceAt(2, 4, "white_bishop");
+    expectMovePiece(2, 4, 3, 4, false);
+    EXPECT_FALSE(board.isKingInCheck("white_king"));
+}
+
+TEST_F(BoardTest, KingInCheckDetection) {
+    EXPECT_FALSE(board.isKingInCheck("white_king"));
+    EXPECT_FALSE(board.isKingInCheck("black_king"));
+
+    board.setPieceAt(2, 5, "black_knight");
+    EXPECT_TRUE(board.isKingInCheck("white_king"));
+    EXPECT_FALSE(board.isKingInCheck("black_king"));
+
+    board.setPieceAt(2, 5, "");
+    board.setPieceAt(4, 1, "white_bishop");
+    EXPECT_FALSE(board.isKingInCheck("black_king"));
+    board.setPieceAt(6, 3, "");
+    EXPECT_TRUE(board.isKingInCheck("black_king"));
 }
 
 TEST_F(BoardTest, WhiteKingInvalidMoves) {
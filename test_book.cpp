@@ -0,0 +1,76 @@
+#include <cstdio>
+#include <gtest/gtest.h>
+#include "include/Book.h"
+
+TEST(BookTest, EncodesMovesLikePolyglot) {
+    EXPECT_EQ(encodeBookMove(Move(squareOf(1, 4), squareOf(3, 4), DoublePush)), 0x031C);
+    EXPECT_EQ(encodeBookMove(Move(squareOf(0, 4), squareOf(0, 6), KingCastle)), encodeBookMove(Move(squareOf(0, 4), squareOf(0, 7))));
+    EXPECT_EQ(encodeBookMove(Move(squareOf(7, 4), squareOf(7, 2), QueenCastle)), encodeBookMove(Move(squareOf(7, 4), squareOf(7, 0))));
+    EXPECT_EQ(encodeBookMove(Move(squareOf(6, 0), squareOf(7, 0), PromoteQueen)) >> 12, 4);
+}
+
+// Keys published with the Polyglot book format, including both en-passant cases: after 1.e4 the
+// e3 square is not keyed because no black pawn can take.
+TEST(BookTest, KeysMatchPolyglotReference) {
+    struct Reference {
+        const char *fen;
+        uint64_t key;
+    };
+    const Reference references[] = {
+        {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 0x463b96181691fc9cull},
+        {"rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1", 0x823c9b50fd114196ull},
+        {"rnbqkbnr/ppp1pppp/8/3p4/4P3/8/PPPP1PPP/RNBQKBNR w KQkq d6 0 2", 0x0756b94461c50fb0ull},
+        {"rnbqkbnr/ppp1pppp/8/3pP3/8/8/PPPP1PPP/RNBQKBNR b KQkq - 0 2", 0x662fafb965db29d4ull},
+        {"rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3", 0x22a48b5a8e47ff78ull},
+        {"rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPPKPPP/RNBQ1BNR b kq - 0 3", 0x652a607ca3f242c1ull},
+        {"rnbq1bnr/ppp1pkpp/8/3pPp2/8/8/PPPPKPPP/RNBQ1BNR w - - 0 4", 0x00fdd303c946bdd9ull},
+        {"rnbqkbnr/p1pppppp/8/8/PpP4P/8/1P1PPPP1/RNBQKBNR b KQkq c3 0 3", 0x3c8123ea7b067637ull},
+        {"rnbqkbnr/p1pppppp/8/8/P6P/R1p5/1P1PPPP1/1NBQKBNR b Kkq - 0 4", 0x5c3f9b829b279560ull},
+    };
+    for (const Reference &reference : references) {
+        Board board;
+        EXPECT_TRUE(board.fromFEN(reference.fen));
+        EXPECT_EQ(bookKey(board), reference.key) << reference.fen;
+    }
+
+    // Played rather than set up, the moves must land on the same keys.
+    Board board;
+    board.initialize();
+    board.makeMove(Move(squareOf(1, 4), squareOf(3, 4), DoublePush));
+    EXPECT_EQ(bookKey(board), references[1].key);
+    board.makeMove(Move(squareOf(6, 3), squareOf(4, 3), DoublePush));
+    EXPECT_EQ(bookKey(board), references[2].key);
+}
+
+TEST(BookTest, ProbesWeightedLegalMoves) {
+    Board board;
+    board.initialize();
+    Move e4(squareOf(1, 4), squareOf(3, 4), DoublePush);
+    Move d4(squareOf(1, 3), squareOf(3, 3), DoublePush);
+    std::vector<BookEntry> entries = {
+        {bookKey(board), encodeBookMove(d4), 10, 0},
+        {bookKey(board), encodeBookMove(e4), 30, 0},
+        {bookKey(board), encodeBookMove(Move(squareOf(1, 4), squareOf(4, 4))), 50, 0},
+        {bookKey(board) + 1, encodeBookMove(e4), 99, 0},
+    };
+    const char *path = "test_book_probe.bin";
+    ASSERT_TRUE(writeBook(path, entries));
+
+    OpeningBook book;
+    ASSERT_TRUE(book.open(path));
+    EXPECT_EQ(book.size(), 4u);
+    std::array<BookMove, 8> moves;
+    ASSERT_EQ(book.probe(board, moves), 2);
+    EXPECT_EQ(moves[0].move, e4);
+    EXPECT_EQ(moves[0].weight, 30);
+    EXPECT_EQ(moves[1].move, d4);
+    EXPECT_EQ(book.pick(board, 5), e4);
+    EXPECT_EQ(book.pick(board, 35), d4);
+
+    board.makeMove(e4);
+    EXPECT_EQ(book.probe(board, moves), 0);
+    EXPECT_EQ(book.pick(board, 0), Move{});
+    book.close();
+    std::remove(path);
+    EXPECT_FALSE(book.open(path));
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include "include/Evaluate.h"
+#include "include/Perft.h"
+
+TEST(EvaluateTest, ScoresMaterialAndSquares) {
+    Board board;
+    board.initialize();
+    EXPECT_EQ(evaluate(board), 0);
+    EXPECT_TRUE(board.fromFEN("4k3/8/8/8/8/8/8/3QK3 w - - 0 1"));
+    // Queen on d1 is worth 900 - 5; both kings stand on squares scored 0.
+    EXPECT_EQ(evaluate(board), 895);
+    board.setSideToMove(Black);
+    EXPECT_EQ(evaluate(board), -895);
+}
+
+TEST(EvaluateTest, MirroredPositionNegatesScore) {
+    Board white;
+    Board black;
+    EXPECT_TRUE(white.fromFEN("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"));
+    EXPECT_TRUE(black.fromFEN("r3k2r/pppbbppp/2n2q1P/1P2p3/3pn3/BN2PNP1/P1PPQPB1/R3K2R b KQkq - 0 1"));
+    EXPECT_EQ(evaluate(white), evaluate(black));
+}
+
+// Every kernel the CPU offers must agree with the scalar one on positions from real play.
+TEST(EvaluateTest, KernelsAgree) {
+    uint64_t state = 0x2545F4914F6CDD1Dull;
+    for (const PerftReference &reference : PerftReferences) {
+        Board board;
+        EXPECT_TRUE(board.fromFEN(reference.fen));
+        for (int ply = 0; ply < 60; ++ply) {
+            int scalar = evaluate(board, EvalKernel::Scalar);
+            for (EvalKernel kernel : {EvalKernel::Sse41, EvalKernel::Avx2}) {
+                if (evalKernelSupported(kernel)) {
+                    EXPECT_EQ(evaluate(board, kernel), scalar);
+                }
+            }
+            int pawns = evaluatePawns(board).score;
+            EXPECT_EQ(evaluate(board), scalar + (board.sideToMove() == White ? pawns : -pawns));
+
+            MoveList moves;
+            board.generateLegalMoves(moves);
+            if (moves.empty()) break;
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            board.makeMove(moves[static_cast<int>(state % moves.size())]);
+        }
+    }
+}
+
+TEST(EvaluateTest, PawnStructureTerms) {
+    Board board;
+    // White: doubled c-pawns, no pawn with a neighbour, passed g6. Black: d6 is backward behind e5.
+    EXPECT_TRUE(board.fromFEN("4k3/8/3p2P1/4p3/2P1P3/2P5/8/4K3 w - - 0 1"));
+    PawnEntry entry = evaluatePawns(board);
+    EXPECT_EQ(entry.passed, squareBB(squareOf(5, 6)));
+    int white = -DoubledPawnPenalty - 4 * IsolatedPawnPenalty + PassedPawnBonus[5];
+    int black = -BackwardPawnPenalty;
+    EXPECT_EQ(entry.score, white - black);
+
+    Board start;
+    start.initialize();
+    EXPECT_EQ(evaluatePawns(start).score, 0);
+}
+
+// Pawns on their last rank never come from play, but a FEN can still place them there.
+TEST(EvaluateTest, PawnStructureAcceptsBackRankPawns) {
+    Board board;
+    EXPECT_TRUE(board.fromFEN("P3k3/1P6/8/8/8/8/6p1/4K2p w - - 0 1"));
+    PawnEntry entry = evaluatePawns(board);
+    EXPECT_EQ(entry.score, 0);
+}
+
+TEST(EvaluateTest, PawnHashTracksPawnsOnly) {
+    Board board;
+    board.initialize();
+    uint64_t start = board.pawnHash();
+    EXPECT_TRUE(board.movePiece(0, 6, 2, 5));
+    EXPECT_EQ(board.pawnHash(), start);
+    EXPECT_TRUE(board.movePiece(6, 3, 4, 3));
+    EXPECT_NE(board.pawnHash(), start);
+
+    Board other;
+    EXPECT_TRUE(other.fromFEN("rnbqkbnr/ppp1pppp/8/3p4/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"));
+    EXPECT_EQ(other.pawnHash(), board.pawnHash());
+
+    PawnHashTable table(16);
+    EXPECT_EQ(table.probe(board).score, evaluatePawns(board).score);
+    EXPECT_EQ(table.probe(other).score, evaluatePawns(board).score);
+    EXPECT_EQ(table.probes(), 2u);
+    EXPECT_EQ(table.hits(), 1u);
+    EXPECT_EQ(table.hitRate(), 500);
+    EXPECT_EQ(evaluate(board, table), evaluate(board));
+}
@@ -0,0 +1,29 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include "include/Board.h"
+#include "include/Instrumentation.h"
+
+TEST(InstrumentationTest, CountsMoveCallsAcrossThreads) {
+    Instrumentation::reset();
+    auto play = [] {
+        Board board;
+        board.initialize();
+        EXPECT_FALSE(board.movePiece(0, 0, 3, 0));  // rook blocked by its own pawn
+        EXPECT_TRUE(board.movePiece(1, 4, 3, 4));
+        EXPECT_TRUE(board.movePiece(0, 5, 3, 2));   // bishop f1-c4 over e2 and d3
+    };
+    play();
+    std::thread(play).join();
+
+    Instrumentation::Snapshot snapshot = Instrumentation::snapshot();
+    uint64_t expected = Instrumentation::Enabled ? 2 : 0;
+    EXPECT_EQ(snapshot.calls[Instrumentation::MoveRook].rejected, expected);
+    EXPECT_EQ(snapshot.calls[Instrumentation::MovePawn].accepted, expected);
+    EXPECT_EQ(snapshot.calls[Instrumentation::MoveBishop].calls, expected);
+    EXPECT_EQ(snapshot.paths[Instrumentation::RookPath].squares, 2 * expected);
+    EXPECT_EQ(snapshot.paths[Instrumentation::BishopPath].squares, 2 * expected);
+    EXPECT_NE(Instrumentation::toJson(snapshot).find("\"moveRook\":{\"calls\":" + std::to_string(expected)), std::string::npos);
+
+    Instrumentation::reset();
+    EXPECT_EQ(Instrumentation::snapshot().calls[Instrumentation::MoveRook].calls, 0u);
+}
@@ -0,0 +1,267 @@
+#include <gtest/gtest.h>
+#include "include/Perft.h"
+
+class MoveGenTest : public ::testing::Test {
+protected:
+    Board board;
+
+    void SetUp() override {
+        board.initialize();
+    }
+
+    void clearBoard() {
+        for (int row = 0; row < 8; ++row) {
+            for (int col = 0; col < 8; ++col) {
+                board.setPieceAt(row, col, "");
+            }
+        }
+    }
+
+    [[nodiscard]] int legalMoveCount() const {
+        MoveList moves;
+        board.generateLegalMoves(moves);
+        return moves.size();
+    }
+
+    [[nodiscard]] bool hasMove(Move move) const {
+        MoveList moves;
+        board.generateLegalMoves(moves);
+        for (Move candidate : moves) {
+            if (candidate == move) return true;
+        }
+        return false;
+    }
+
+    // Walks the tree with movePiece on board copies; valid while no promotion occurs.
+    static long countLeaves(const Board &position, int depth) {
+        if (depth == 0) return 1;
+        MoveList moves;
+        position.generateLegalMoves(moves);
+        long nodes = 0;
+        for (Move move : moves) {
+            Board next = position;
+            EXPECT_TRUE(next.movePiece(rowOf(move.from()), colOf(move.from()), rowOf(move.to()), colOf(move.to())));
+            nodes += countLeaves(next, depth - 1);
+        }
+        return nodes;
+    }
+};
+
+// Plays every line to the given depth with makeMove and checks unmakeMove restores the board exactly.
+static long walkMakeUnmake(Board &position, int depth) {
+    if (depth == 0) return 1;
+    MoveList moves;
+    position.generateLegalMoves(moves);
+    long nodes = 0;
+    for (Move move : moves) {
+        Board before = position;
+        Undo undo = position.makeMove(move);
+        nodes += walkMakeUnmake(position, depth - 1);
+        position.unmakeMove(move, undo);
+        EXPECT_EQ(position, before);
+    }
+    return nodes;
+}
+
+TEST_F(MoveGenTest, StartPosition) {
+    EXPECT_EQ(legalMoveCount(), 20);
+    EXPECT_EQ(countLeaves(board, 3), 8902);
+}
+
+TEST_F(MoveGenTest, BlackRepliesAfterMovePiece) {
+    EXPECT_TRUE(board.movePiece(1, 4, 3, 4));
+    EXPECT_EQ(board.sideToMove(), Black);
+    EXPECT_EQ(board.enPassantSquare(), squareOf(2, 4));
+    EXPECT_EQ(legalMoveCount(), 20);
+}
+
+TEST_F(MoveGenTest, GeneratesEnPassant) {
+    board.setPieceAt(4, 4, "white_pawn");
+    EXPECT_TRUE(board.movePiece(6, 3, 4, 3));
+    EXPECT_TRUE(hasMove(Move(squareOf(4, 4), squareOf(5, 3), EnPassant)));
+}
+
+TEST_F(MoveGenTest, GeneratesAllPromotions) {
+    clearBoard();
+    board.setPieceAt(0, 4, "white_king");
+    board.setPieceAt(7, 7, "black_king");
+    board.setPieceAt(6, 0, "white_pawn");
+    board.setPieceAt(7, 1, "black_rook");
+    for (int flag : {PromoteKnight, PromoteBishop, PromoteRook, PromoteQueen,
+                     PromoteKnightCapture, PromoteBishopCapture, PromoteRookCapture, PromoteQueenCapture}) {
+        int to = (flag & Capture) ? squareOf(7, 1) : squareOf(7, 0);
+        EXPECT_TRUE(hasMove(Move(squareOf(6, 0), to, flag)));
+    }
+}
+
+TEST_F(MoveGenTest, GeneratesCastling) {
+    board.setPieceAt(0, 5, "");
+    board.setPieceAt(0, 6, "");
+    EXPECT_TRUE(hasMove(Move(squareOf(0, 4), squareOf(0, 6), KingCastle)));
+    EXPECT_FALSE(hasMove(Move(squareOf(0, 4), squareOf(0, 2), QueenCastle)));
+}
+
+TEST_F(MoveGenTest, PinnedPieceCannotLeaveTheLine) {
+    clearBoard();
+    board.setPieceAt(0, 4, "white_king");
+    board.setPieceAt(1, 4, "white_knight");
+    board.setPieceAt(7, 4, "black_rook");
+    board.setPieceAt(7, 0, "black_king");
+    EXPECT_EQ(legalMoveCount(), 4);
+}
+
+TEST_F(MoveGenTest, CheckmateHasNoMoves) {
+    clearBoard();
+    board.setPieceAt(7, 7, "black_king");
+    board.setPieceAt(6, 6, "white_queen");
+    board.setPieceAt(5, 5, "white_king");
+    board.setSideToMove(Black);
+    EXPECT_EQ(legalMoveCount(), 0);
+}
+
+TEST_F(MoveGenTest, MakeUnmakeRestoresPosition) {
+    EXPECT_EQ(walkMakeUnmake(board, 3), 8902);
+}
+
+TEST_F(MoveGenTest, MakeUnmakeSpecialMoves) {
+    clearBoard();
+    board.setPieceAt(0, 4, "white_king");
+    board.setPieceAt(0, 0, "white_rook");
+    board.setPieceAt(0, 7, "white_rook");
+    board.setPieceAt(6, 1, "white_pawn");
+    board.setPieceAt(7, 0, "black_rook");
+    board.setPieceAt(7, 4, "black_king");
+    board.setPieceAt(4, 3, "white_pawn");
+    EXPECT_TRUE(board.movePiece(7, 0, 6, 0));
+    EXPECT_TRUE(board.movePiece(0, 7, 1, 7));
+    board.setPieceAt(6, 4, "black_pawn");
+    EXPECT_TRUE(board.movePiece(6, 4, 4, 4));
+
+    MoveList moves;
+    board.generateLegalMoves(moves);
+    int specials = 0;
+    for (Move move : moves) {
+        if (!move.isPromotion() && !move.isCastle() && move.flag() != EnPassant) continue;
+        ++specials;
+        Board before = board;
+        Undo undo = board.makeMove(move);
+        EXPECT_NE(board, before);
+        board.unmakeMove(move, undo);
+        EXPECT_EQ(board, before);
+    }
+    EXPECT_EQ(specials, 6);
+}
+
+TEST_F(MoveGenTest, MakeMoveUpdatesClocks) {
+    board.makeMove(Move(squareOf(0, 6), squareOf(2, 5)));
+    EXPECT_EQ(board.halfmoveClock(), 1);
+    EXPECT_EQ(board.fullmoveNumber(), 1);
+    board.makeMove(Move(squareOf(6, 4), squareOf(4, 4), DoublePush));
+    EXPECT_EQ(board.halfmoveClock(), 0);
+    EXPECT_EQ(board.fullmoveNumber(), 2);
+    EXPECT_EQ(board.enPassantSquare(), squareOf(5, 4));
+}
+
+TEST_F(MoveGenTest, FromFenMatchesInitialize) {
+    Board parsed;
+    EXPECT_TRUE(parsed.fromFEN(StartFEN));
+    EXPECT_EQ(parsed, board);
+    EXPECT_FALSE(parsed.fromFEN("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP w KQkq - 0 1"));
+    EXPECT_EQ(parsed, board);
+}
+
+TEST_F(MoveGenTest, FromFenRejectsOverlongCounters) {
+    Board parsed;
+    EXPECT_FALSE(parsed.fromFEN("4k3/8/8/8/8/8/8/4K3 w - - 0 99999"));
+    EXPECT_FALSE(parsed.fromFEN("4k3/8/8/8/8/8/8/4K3 w - - 65536 1"));
+    EXPECT_FALSE(parsed.fromFEN("4k3/8/8/8/8/8/8/4K3 w - - 0 4294967297"));
+    EXPECT_TRUE(parsed.fromFEN("4k3/8/8/8/8/8/8/4K3 w - - 65534 65535"));
+    EXPECT_EQ(parsed.halfmoveClock(), 65534);
+    EXPECT_EQ(parsed.fullmoveNumber(), 65535);
+
+    // Played on from there, the counters stop at the limit and unmaking restores them exactly.
+    Move white(squareOf(0, 4), squareOf(0, 3));
+    Move black(squareOf(7, 4), squareOf(7, 3));
+    Undo first = parsed.makeMove(white);
+    Undo second = parsed.makeMove(black);
+    EXPECT_EQ(parsed.halfmoveClock(), 65535);
+    EXPECT_EQ(parsed.fullmoveNumber(), 65535);
+    parsed.unmakeMove(black, second);
+    parsed.unmakeMove(white, first);
+    EXPECT_EQ(parsed.halfmoveClock(), 65534);
+    EXPECT_EQ(parsed.fullmoveNumber(), 65535);
+}
+
+TEST_F(MoveGenTest, HashFollowsPositionNotHistory) {
+    uint64_t start = board.hash();
+    EXPECT_TRUE(board.movePiece(0, 6, 2, 5));
+    EXPECT_NE(board.hash(), start);
+    EXPECT_TRUE(board.movePiece(7, 6, 5, 5));
+    EXPECT_TRUE(board.movePiece(2, 5, 0, 6));
+    EXPECT_TRUE(board.movePiece(5, 5, 7, 6));
+    EXPECT_EQ(board.hash(), start);
+
+    Board transposed;
+    transposed.initialize();
+    EXPECT_TRUE(transposed.movePiece(1, 4, 3, 4));
+    EXPECT_TRUE(transposed.movePiece(6, 4, 4, 4));
+    EXPECT_TRUE(transposed.movePiece(0, 6, 2, 5));
+    Board other;
+    EXPECT_TRUE(other.fromFEN("rnbqkbnr/pppp1ppp/8/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R b KQkq - 1 2"));
+    EXPECT_EQ(transposed.hash(), other.hash());
+}
+
+TEST_F(MoveGenTest, HashDistinguishesSideCastlingAndEnPassant) {
+    uint64_t start = board.hash();
+    board.setSideToMove(Black);
+    EXPECT_NE(board.hash(), start);
+    board.setSideToMove(White);
+    EXPECT_EQ(board.hash(), start);
+
+    Board withoutCastling;
+    EXPECT_TRUE(withoutCastling.fromFEN("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w Kkq - 0 1"));
+    EXPECT_NE(withoutCastling.hash(), start);
+
+    Board a;
+    Board b;
+    EXPECT_TRUE(a.fromFEN("4k3/8/8/8/4P3/8/8/4K3 b - e3 0 1"));
+    EXPECT_TRUE(b.fromFEN("4k3/8/8/8/4P3/8/8/4K3 b - - 0 1"));
+    EXPECT_NE(a.hash(), b.hash());
+}
+
+TEST_F(MoveGenTest, ParallelPerftMatchesSerial) {
+    for (const PerftReference &reference : {PerftReferences[1], PerftReferences[3]}) {
+        Board position;
+        EXPECT_TRUE(position.fromFEN(reference.fen));
+        EXPECT_EQ(parallelPerft(position, 4, 3), reference.nodes[3]) << reference.name;
+        EXPECT_EQ(parallelPerft(position, 4, 1), perft(position, 4)) << reference.name;
+    }
+
+    // Mated and stalemated roots leave nothing to split.
+    for (std::string_view fen : {"7k/6Q1/5K2/8/8/8/8/8 b - - 0 1", "7k/5Q2/6K1/8/8/8/8/8 b - - 0 1"}) {
+        Board position;
+        EXPECT_TRUE(position.fromFEN(fen));
+        EXPECT_EQ(parallelPerft(position, 4, 4), perft(position, 4)) << fen;
+        EXPECT_EQ(parallelPerft(position, 4, 4), 0u) << fen;
+    }
+}
+
+TEST_F(MoveGenTest, ToFenRoundTrips) {
+    char fen[MaxFENLength];
+    EXPECT_EQ(board.toFEN(fen), static_cast<int>(StartFEN.size()));
+    EXPECT_EQ(std::string_view(fen), StartFEN);
+
+    for (const PerftReference &reference : PerftReferences) {
+        Board position;
+        EXPECT_TRUE(position.fromFEN(reference.fen));
+        position.toFEN(fen);
+        EXPECT_EQ(std::string_view(fen), reference.fen);
+    }
+
+    EXPECT_TRUE(board.movePiece(1, 4, 3, 4));
+    board.toFEN(fen);
+    EXPECT_STREQ(fen, "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1");
+    Board parsed;
+    EXPECT_TRUE(parsed.fromFEN(fen));
+    EXPECT_EQ(parsed, board);
+}
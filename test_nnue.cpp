@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <memory>
+#include "include/Evaluate.h"
+#include "include/Perft.h"
+#include "include/Search.h"
+
+class NnueTest : public ::testing::Test {
+protected:
+    std::unique_ptr<Nnue::Network> network = std::make_unique<Nnue::Network>();
+
+    void SetUp() override {
+        uint64_t state = 0x853C49E6748FEA9Bull;
+        auto next = [&state] {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return static_cast<int16_t>(static_cast<int>(state % 65) - 32);
+        };
+        for (auto &column : network->featureWeights) {
+            for (int16_t &weight : column) weight = next();
+        }
+        for (int16_t &bias : network->featureBias) bias = static_cast<int16_t>(next() + 64);
+        for (auto &perspective : network->outputWeights) {
+            for (int16_t &weight : perspective) weight = next();
+        }
+        network->outputBias = 1000;
+    }
+};
+
+// Deltas from makeMove, unmakeMove and setPieceAt must leave the same sums as a full refresh.
+TEST_F(NnueTest, IncrementalUpdatesMatchRefresh) {
+    Nnue::Accumulator incremental(*network);
+    Nnue::Accumulator fresh(*network);
+    uint64_t state = 7;
+    for (const PerftReference &reference : PerftReferences) {
+        Board board;
+        EXPECT_TRUE(board.fromFEN(reference.fen));
+        board.attachAccumulator(&incremental);
+        for (int ply = 0; ply < 40; ++ply) {
+            MoveList moves;
+            board.generateLegalMoves(moves);
+            if (moves.empty()) break;
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            Move move = moves[static_cast<int>((state >> 33) % moves.size())];
+
+            Undo undo = board.makeMove(move);
+            fresh.refresh(board);
+            EXPECT_EQ(evaluate(board), fresh.evaluate(board.sideToMove()));
+            board.unmakeMove(move, undo);
+            fresh.refresh(board);
+            EXPECT_EQ(evaluate(board), fresh.evaluate(board.sideToMove()));
+            board.makeMove(move);
+        }
+        board.setPieceAt(3, 3, "white_queen");
+        board.setPieceAt(0, 0, "");
+        fresh.refresh(board);
+        EXPECT_EQ(incremental.evaluate(White), fresh.evaluate(White));
+
+        Board copy = board;
+        EXPECT_EQ(copy.accumulator(), nullptr);
+        EXPECT_EQ(copy, board);
+    }
+}
+
+TEST_F(NnueTest, SaveAndLoadRoundTrip) {
+    const char *path = "test_nnue_roundtrip.nnue";
+    ASSERT_TRUE(Nnue::save(*network, path));
+    auto loaded = std::make_unique<Nnue::Network>();
+    ASSERT_TRUE(Nnue::load(*loaded, path));
+    std::remove(path);
+
+    Board board;
+    board.initialize();
+    Nnue::Accumulator original(*network);
+    Nnue::Accumulator reloaded(*loaded);
+    original.refresh(board);
+    reloaded.refresh(board);
+    EXPECT_EQ(original.evaluate(White), reloaded.evaluate(White));
+    EXPECT_FALSE(Nnue::load(*loaded, "does_not_exist.nnue"));
+}
+
+TEST_F(NnueTest, SearchUsesNetwork) {
+    TranspositionTable table(1);
+    Search search(table);
+    search.setNetwork(network.get());
+    Board board;
+    EXPECT_TRUE(board.fromFEN("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1"));
+    SearchResult result = search.run(board, {3, 0, 0});
+    EXPECT_EQ(result.score, MateScore - 1);
+    search.setNetwork(nullptr);
+    EXPECT_EQ(search.run(board, {3, 0, 0}).score, MateScore - 1);
+}
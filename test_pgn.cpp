@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include "include/Pgn.h"
+
+namespace {
+    constexpr std::string_view SampleGames = R"([Event "Opera"]
+[White "Morphy"]
+[Black "Duke of Brunswick and Count Isouard"]
+[Result "1-0"]
+
+1. e4 e5 2. Nf3 d6 3. d4 Bg4 {This is a weak move} 4. dxe5 Bxf3 5. Qxf3 dxe5
+6. Bc4 Nf6 7. Qb3 Qe7 8. Nc3 c6 9. Bg5 b5 10. Nxb5 cxb5 11. Bxb5+ Nbd7
+12. O-O-O Rd8 13. Rxd7 Rxd7 14. Rd1 Qe6 15. Bxd7+ Nxd7 16. Qb8+ Nxb8 17. Rd8# 1-0
+
+[Event "Broken"]
+[Result "*"]
+
+1. e4 e5 2. Ke3 *
+
+[Event "Promotion"]
+[FEN "8/P6k/8/8/8/8/6pK/8 w - - 0 1"]
+[SetUp "1"]
+
+1. a8=N Kg6 (1... g1=Q+ 2. Kxg1) 2. Kxg2 $1 Kf5 1/2-1/2
+)";
+}
+
+TEST(PgnTest, ParsesSan) {
+    Board board;
+    board.initialize();
+    EXPECT_EQ(parseSan(board, "Nf3"), Move(squareOf(0, 6), squareOf(2, 5)));
+    EXPECT_EQ(parseSan(board, "e4"), Move(squareOf(1, 4), squareOf(3, 4), DoublePush));
+    EXPECT_EQ(parseSan(board, "e5"), Move{});
+    EXPECT_EQ(parseSan(board, "Nd2"), Move{});
+
+    EXPECT_TRUE(board.fromFEN("r3k2r/8/8/3pP3/8/8/8/R3K2R w KQkq d6 0 1"));
+    EXPECT_EQ(parseSan(board, "exd6"), Move(squareOf(4, 4), squareOf(5, 3), EnPassant));
+    EXPECT_EQ(parseSan(board, "O-O-O"), Move(squareOf(0, 4), squareOf(0, 2), QueenCastle));
+    EXPECT_EQ(parseSan(board, "Rd1"), Move(squareOf(0, 0), squareOf(0, 3)));
+    EXPECT_EQ(parseSan(board, "Rb1"), Move(squareOf(0, 0), squareOf(0, 1)));
+
+    // Both knights reach d2, so the move needs its file or rank.
+    EXPECT_TRUE(board.fromFEN("4k3/8/8/8/8/5N2/8/RN2K2R w - - 0 1"));
+    EXPECT_EQ(parseSan(board, "Nd2"), Move{});
+    EXPECT_EQ(parseSan(board, "Nbd2"), Move(squareOf(0, 1), squareOf(1, 3)));
+    EXPECT_EQ(parseSan(board, "N3d2"), Move(squareOf(2, 5), squareOf(1, 3)));
+
+    EXPECT_TRUE(board.fromFEN("8/P6k/8/8/8/8/8/K7 w - - 0 1"));
+    EXPECT_EQ(parseSan(board, "a8=R+"), Move(squareOf(6, 0), squareOf(7, 0), PromoteRook));
+    EXPECT_EQ(parseSan(board, "a8Q"), Move(squareOf(6, 0), squareOf(7, 0), PromoteQueen));
+    EXPECT_EQ(parseSan(board, "a8"), Move{});
+}
+
+TEST(PgnTest, ReadsTagsAndReplaysGames) {
+    PgnReader reader(SampleGames);
+    PgnGame game;
+    Board board;
+    int plies = 0;
+
+    ASSERT_TRUE(reader.next(game));
+    EXPECT_EQ(game.tagCount, 4);
+    EXPECT_EQ(game.tag("White"), "Morphy");
+    EXPECT_EQ(game.tag("Round"), "");
+    EXPECT_TRUE(replayGame(game, board, plies));
+    EXPECT_EQ(plies, 33);
+    MoveList moves;
+    board.generateLegalMoves(moves);
+    EXPECT_TRUE(moves.empty());
+    EXPECT_TRUE(board.isKingInCheck(Black));
+
+    ASSERT_TRUE(reader.next(game));
+    EXPECT_EQ(game.tag("Event"), "Broken");
+    EXPECT_FALSE(replayGame(game, board, plies));
+    EXPECT_EQ(plies, 2);
+
+    ASSERT_TRUE(reader.next(game));
+    EXPECT_TRUE(replayGame(game, board, plies));
+    EXPECT_EQ(plies, 4);
+    EXPECT_EQ(board.pieceAt(7, 0), WhiteKnight);
+    EXPECT_EQ(board.pieceAt(1, 6), WhiteKing);
+
+    EXPECT_FALSE(reader.next(game));
+    EXPECT_EQ(reader.position(), SampleGames.size());
+}
+
+TEST(PgnTest, FindsGameStartsFromAnyOffset) {
+    size_t second = SampleGames.find("[Event \"Broken\"]");
+    size_t third = SampleGames.find("[Event \"Promotion\"]");
+    EXPECT_EQ(findGameStart(SampleGames, 0), 0u);
+    EXPECT_EQ(findGameStart(SampleGames, 1), second);
+    EXPECT_EQ(findGameStart(SampleGames, second), second);
+    EXPECT_EQ(findGameStart(SampleGames, second + 3), third);
+    EXPECT_EQ(findGameStart(SampleGames, SampleGames.find("[FEN")), SampleGames.size());
+
+    // Games glued together without a blank line still split.
+    constexpr std::string_view glued = "[Event \"a\"]\n1. e4 *\n[Event \"b\"]\n[Round \"2\"]\n1. d4 *\n";
+    EXPECT_EQ(findGameStart(glued, 5), glued.find("[Event \"b\"]"));
+
+    // Movetext-only games start where PgnReader starts reading.
+    constexpr std::string_view untagged = "\n\n1. e4 e5 2. Nf3 *\n";
+    EXPECT_EQ(findGameStart(untagged, 0), 2u);
+    PgnReader reader(untagged.substr(findGameStart(untagged, 0)));
+    PgnGame game;
+    Board board;
+    int plies = 0;
+    ASSERT_TRUE(reader.next(game));
+    EXPECT_TRUE(replayGame(game, board, plies));
+    EXPECT_EQ(plies, 3);
+}
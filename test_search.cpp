@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "include/ParallelSearch.h"
+
+class SearchTest : public ::testing::Test {
+protected:
+    TranspositionTable table{4};
+    Search search{table};
+
+    SearchResult searchFen(std::string_view fen, int depth) {
+        Board board;
+        EXPECT_TRUE(board.fromFEN(fen));
+        return search.run(board, {depth, 0, 0});
+    }
+};
+
+TEST_F(SearchTest, FindsMateInOne) {
+    SearchResult result = searchFen("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1", 3);
+    EXPECT_EQ(result.bestMove, Move(squareOf(0, 0), squareOf(7, 0)));
+    EXPECT_EQ(result.score, MateScore - 1);
+}
+
+TEST_F(SearchTest, WinsHangingQueen) {
+    SearchResult result = searchFen("4k3/8/8/3q4/8/8/8/3RK3 w - - 0 1", 2);
+    EXPECT_EQ(result.bestMove, Move(squareOf(0, 3), squareOf(4, 3), Capture));
+    EXPECT_GT(result.score, 300);
+}
+
+TEST_F(SearchTest, AvoidsLosingQueenToPawn) {
+    SearchResult result = searchFen("4k3/8/8/2p5/8/3Q4/8/4K3 w - - 0 1", 4);
+    EXPECT_NE(result.bestMove, Move(squareOf(2, 3), squareOf(3, 3)));
+    EXPECT_GT(result.score, 500);
+}
+
+TEST_F(SearchTest, StalemateAndCheckmateHaveNoMove) {
+    SearchResult stalemate = searchFen("7k/5Q2/6K1/8/8/8/8/8 b - - 0 1", 3);
+    EXPECT_EQ(stalemate.bestMove, Move{});
+    EXPECT_EQ(stalemate.score, 0);
+
+    SearchResult mated = searchFen("7k/6Q1/6K1/8/8/8/8/8 b - - 0 1", 3);
+    EXPECT_EQ(mated.bestMove, Move{});
+    EXPECT_EQ(mated.score, -MateScore);
+}
+
+TEST_F(SearchTest, ReportsIterationsAndPrincipalVariation) {
+    int iterations = 0;
+    search.onIteration([&](const SearchInfo &info) {
+        ++iterations;
+        EXPECT_EQ(info.depth, iterations);
+        EXPECT_GT(info.pv.length, 0);
+    });
+    Board board;
+    board.initialize();
+    SearchResult result = search.run(board, {4, 0, 0});
+    EXPECT_EQ(iterations, 4);
+    EXPECT_EQ(result.depth, 4);
+    EXPECT_GT(result.nodes, 0u);
+    EXPECT_EQ(result.pv.moves[0], result.bestMove);
+
+    // The principal variation must be playable from the root.
+    for (int i = 0; i < result.pv.length; ++i) {
+        MoveList moves;
+        board.generateLegalMoves(moves);
+        EXPECT_NE(std::find(moves.begin(), moves.end(), result.pv.moves[i]), moves.end());
+        board.makeMove(result.pv.moves[i]);
+    }
+}
+
+TEST_F(SearchTest, RespectsNodeLimit) {
+    Board board;
+    board.initialize();
+    SearchResult result = search.run(board, {MaxPly - 1, 0, 20000});
+    EXPECT_GE(result.depth, 1);
+    EXPECT_LT(result.nodes, 25000u);
+    EXPECT_NE(result.bestMove, Move{});
+}
+
+TEST_F(SearchTest, RepetitionScoresAsDraw) {
+    // Black is a queen up; white's only escape is to return to a position seen earlier in the game.
+    Board board;
+    EXPECT_TRUE(board.fromFEN("6k1/8/8/8/8/8/8/q5K1 w - - 10 40"));
+    EXPECT_LT(search.run(board, {4, 0, 0}).score, -500);
+
+    Move escape(squareOf(0, 6), squareOf(1, 6));
+    Undo undo = board.makeMove(escape);
+    uint64_t repeated = board.hash();
+    board.unmakeMove(escape, undo);
+
+    uint64_t history[] = {1, repeated, 2, 3};
+    table.clear();
+    SearchResult result = search.run(board, {4, 0, 0}, history);
+    EXPECT_EQ(result.bestMove, escape);
+    EXPECT_EQ(result.score, 0);
+}
+
+TEST_F(SearchTest, ParallelSearchFindsMate) {
+    ParallelSearch parallel(table, 3);
+    Board board;
+    EXPECT_TRUE(board.fromFEN("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1"));
+    SearchResult result = parallel.run(board, {4, 0, 0});
+    EXPECT_EQ(result.bestMove, Move(squareOf(0, 0), squareOf(7, 0)));
+    EXPECT_EQ(result.score, MateScore - 1);
+    EXPECT_GE(result.nodes, parallel.nodeCount() / 2);
+}
+
+// Helpers stopped by worker 0 must not report their unfinished, one-deeper iteration.
+TEST_F(SearchTest, ParallelSearchReportsFinishedIterations) {
+    Board board;
+    board.initialize();
+    for (int depth = 1; depth <= 3; ++depth) {
+        for (int threads : {2, 3}) {
+            TranspositionTable fresh(4);
+            ParallelSearch parallel(fresh, threads);
+            SearchResult result = parallel.run(board, {depth, 0, 0});
+            ASSERT_GT(result.pv.length, 0);
+            EXPECT_EQ(result.bestMove, result.pv.moves[0]);
+            EXPECT_GE(result.depth, depth);
+        }
+    }
+}
+
+TEST_F(SearchTest, ParallelSearchStopsOnRequest) {
+    ParallelSearch parallel(table, 2);
+    Board board;
+    board.initialize();
+    parallel.start(board, {});
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    auto stopAt = std::chrono::steady_clock::now();
+    parallel.stop();
+    SearchResult result = parallel.wait();
+    EXPECT_LT(std::chrono::steady_clock::now() - stopAt, std::chrono::milliseconds(100));
+    EXPECT_NE(result.bestMove, Move{});
+    EXPECT_FALSE(parallel.searching());
+
+    // Stop issued immediately after start must not be lost.
+    parallel.start(board, {});
+    parallel.stop();
+    EXPECT_NE(parallel.wait().bestMove, Move{});
+}
+
+TEST_F(SearchTest, MovePickerRanksCapturesThenKillersThenHistory) {
+    Board board;
+    EXPECT_TRUE(board.fromFEN("4k3/8/8/3q4/4P3/1r6/8/R3K2N w - - 0 1"));
+    MoveList moves;
+    board.generateLegalMoves(moves);
+    int total = moves.size();
+
+    MoveOrdering ordering;
+    Move killer(squareOf(0, 7), squareOf(2, 6));
+    Move historyMove(squareOf(0, 0), squareOf(0, 2));
+    ordering.updateQuiet(board, historyMove, Move{}, 3, 6, {});
+    ordering.updateQuiet(board, killer, Move{}, 2, 1, {});
+    Move ttMove(squareOf(0, 4), squareOf(1, 4));
+
+    MovePicker picker(board, moves, ttMove, &ordering, 2, Move{});
+    std::vector<Move> order;
+    for (Move move; picker.next(move);) order.push_back(move);
+    ASSERT_EQ(static_cast<int>(order.size()), total);
+    EXPECT_EQ(order[0], ttMove);
+    EXPECT_EQ(order[1], Move(squareOf(3, 4), squareOf(4, 3), Capture)); // pawn takes queen
+    EXPECT_EQ(order[2], killer);
+    EXPECT_EQ(order[3], historyMove);
+
+    ordering.setHeuristics(MvvLvaOnly);
+    EXPECT_EQ(ordering.killer(2, 0), Move{});
+    EXPECT_EQ(ordering.history(White, historyMove), 0);
+}
@@ -0,0 +1,138 @@
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <map>
+#include "include/Search.h"
+#include "include/Tablebase.h"
+
+class TablebaseTest : public ::testing::Test {
+protected:
+    static void SetUpTestSuite() {
+        tables = new Tablebases;
+        for (const char *signature : {"KQK", "KRK", "KPK"}) {
+            ASSERT_TRUE(tables->generate(signature, 2, [](const TablebaseReport &report) {
+                longestMates[report.signature] = report.longestMate;
+            }));
+        }
+    }
+
+    static void TearDownTestSuite() {
+        delete tables;
+        tables = nullptr;
+    }
+
+    static TablebaseResult probeFen(std::string_view fen) {
+        Board board;
+        EXPECT_TRUE(board.fromFEN(fen));
+        TablebaseResult result{};
+        EXPECT_TRUE(board.probeTablebase(*tables, result));
+        return result;
+    }
+
+    // The stored result must follow from the results after each move.
+    static void expectConsistent(std::string_view fen) {
+        Board board;
+        ASSERT_TRUE(board.fromFEN(fen));
+        TablebaseResult result{};
+        ASSERT_TRUE(board.probeTablebase(*tables, result));
+        MoveList moves;
+        board.generateLegalMoves(moves);
+        int bestWin = 1000;
+        int longestLoss = -1;
+        bool draw = false;
+        for (Move move : moves) {
+            Board child = board;
+            child.makeMove(move);
+            TablebaseResult after{};
+            ASSERT_TRUE(child.probeTablebase(*tables, after)) << fen;
+            if (after.wdl < 0) bestWin = std::min(bestWin, after.plies + 1);
+            else if (after.wdl > 0) longestLoss = std::max(longestLoss, after.plies + 1);
+            else draw = true;
+        }
+        if (result.wdl > 0) EXPECT_EQ(result.plies, bestWin) << fen;
+        else if (result.wdl < 0) EXPECT_TRUE(bestWin == 1000 && !draw && result.plies == longestLoss) << fen;
+        else EXPECT_TRUE(bestWin == 1000 && (draw || moves.empty())) << fen;
+    }
+
+    static Tablebases *tables;
+    static std::map<std::string, int> longestMates;
+};
+
+Tablebases *TablebaseTest::tables = nullptr;
+std::map<std::string, int> TablebaseTest::longestMates;
+
+TEST_F(TablebaseTest, LongestMatesMatchKnownValues) {
+    EXPECT_EQ(longestMates["KQK"], 20);
+    EXPECT_EQ(longestMates["KRK"], 32);
+    EXPECT_EQ(tables->maxPieces(), 3);
+    EXPECT_TRUE(tables->contains("KKQ"));
+    EXPECT_FALSE(tables->contains("KRKP"));
+}
+
+TEST_F(TablebaseTest, ProbesMatesAndDraws) {
+    TablebaseResult mateInOne = probeFen("k7/8/1K6/8/8/8/8/6Q1 w - - 0 1");
+    EXPECT_EQ(mateInOne.wdl, 1);
+    EXPECT_EQ(mateInOne.plies, 1);
+    TablebaseResult mated = probeFen("k6Q/8/1K6/8/8/8/8/8 b - - 0 1");
+    EXPECT_EQ(mated.wdl, -1);
+    EXPECT_EQ(mated.plies, 0);
+    EXPECT_EQ(probeFen("k7/2Q5/1K6/8/8/8/8/8 b - - 0 1").wdl, 0);
+    EXPECT_EQ(probeFen("7K/8/8/8/8/8/1kQ5/8 b - - 0 1").wdl, 0);
+    EXPECT_EQ(probeFen("k7/8/8/8/8/8/P7/K7 w - - 0 1").wdl, 0);
+    EXPECT_EQ(probeFen("8/8/8/8/8/8/k3P3/4K3 w - - 0 1").wdl, 1);
+
+    // The same ending with colours swapped is answered from the same table.
+    TablebaseResult flipped = probeFen("8/7q/8/8/8/1k6/8/K7 b - - 0 1");
+    TablebaseResult original = probeFen("k7/8/1K6/8/8/8/7Q/8 w - - 0 1");
+    EXPECT_EQ(flipped.wdl, original.wdl);
+    EXPECT_EQ(flipped.plies, original.plies);
+
+    Board castling;
+    ASSERT_TRUE(castling.fromFEN("4k3/8/8/8/8/8/8/4K2R w K - 0 1"));
+    TablebaseResult result{};
+    EXPECT_FALSE(castling.probeTablebase(*tables, result));
+}
+
+TEST_F(TablebaseTest, ResultsFollowFromTheirMoves) {
+    for (std::string_view fen : {"8/8/8/4k3/8/8/8/4K2R w - - 0 1", "8/8/8/4k3/8/8/8/4K2R b - - 0 1",
+                                 "8/8/3k4/8/8/8/2Q5/4K3 w - - 0 1", "k7/8/1K6/8/8/8/8/6Q1 w - - 0 1",
+                                 "8/4P3/8/8/2k5/8/8/K7 w - - 0 1", "8/4k3/8/4P3/4K3/8/8/8 b - - 0 1",
+                                 "8/8/8/8/8/4k3/4P3/4K3 b - - 0 1", "8/8/8/8/8/8/k3P3/4K3 w - - 0 1"}) {
+        expectConsistent(fen);
+    }
+}
+
+TEST_F(TablebaseTest, SavedTablesLoadBack) {
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "chess_tablebase_test";
+    std::filesystem::create_directories(directory);
+    ASSERT_TRUE(tables->save("KRK", directory.c_str()));
+
+    Tablebases loaded;
+    ASSERT_TRUE(loaded.load(directory.c_str()));
+    EXPECT_TRUE(loaded.contains("KRK"));
+    Board board;
+    ASSERT_TRUE(board.fromFEN("8/8/8/4k3/8/8/8/4K2R b - - 0 1"));
+    TablebaseResult expected{};
+    TablebaseResult actual{};
+    ASSERT_TRUE(board.probeTablebase(*tables, expected));
+    ASSERT_TRUE(board.probeTablebase(loaded, actual));
+    EXPECT_EQ(actual.wdl, expected.wdl);
+    EXPECT_EQ(actual.plies, expected.plies);
+    std::filesystem::remove_all(directory);
+
+    EXPECT_FALSE(loaded.generate("KQQQK", 1));
+    EXPECT_FALSE(loaded.generate("QKK", 1));
+    EXPECT_FALSE(loaded.generate("KPKP", 1));
+    EXPECT_FALSE(loaded.contains("KPKP"));
+}
+
+TEST_F(TablebaseTest, SearchScoresTableMatesExactly) {
+    TranspositionTable table{4};
+    Search search{table};
+    search.setTablebases(tables);
+    Board board;
+    ASSERT_TRUE(board.fromFEN("8/8/3k4/8/8/8/2Q5/4K3 w - - 0 1"));
+    TablebaseResult expected{};
+    ASSERT_TRUE(board.probeTablebase(*tables, expected));
+    SearchResult result = search.run(board, {2, 0, 0});
+    EXPECT_EQ(result.score, MateScore - expected.plies);
+}
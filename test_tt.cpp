@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "include/TranspositionTable.h"
+
+TEST(TranspositionTableTest, StoresAndProbes) {
+    TranspositionTable table(1);
+    TTEntry entry{};
+    EXPECT_FALSE(table.probe(0x1234, entry));
+
+    Move move(squareOf(1, 4), squareOf(3, 4), DoublePush);
+    table.store(0x1234, move, -321, 17, 9, LowerBound);
+    ASSERT_TRUE(table.probe(0x1234, entry));
+    EXPECT_EQ(entry.move, move);
+    EXPECT_EQ(entry.score, -321);
+    EXPECT_EQ(entry.eval, 17);
+    EXPECT_EQ(entry.depth, 9);
+    EXPECT_EQ(entry.bound, LowerBound);
+    EXPECT_FALSE(table.probe(0x1235, entry));
+
+    table.clear();
+    EXPECT_FALSE(table.probe(0x1234, entry));
+}
+
+TEST(TranspositionTableTest, ClampsDepthsBeyondTheField) {
+    TranspositionTable table(1, ReplacementPolicy::DepthPreferred);
+    TTEntry entry{};
+    table.store(7, Move{}, 0, 0, 140, ExactBound);
+    ASSERT_TRUE(table.probe(7, entry));
+    EXPECT_EQ(entry.depth, 127);
+
+    // Still the deepest entry: a shallower lower bound does not replace it.
+    table.store(7, Move{}, 50, 0, 100, LowerBound);
+    ASSERT_TRUE(table.probe(7, entry));
+    EXPECT_EQ(entry.bound, ExactBound);
+}
+
+TEST(TranspositionTableTest, KeepsBestMoveWhenStoreHasNone) {
+    TranspositionTable table(1);
+    Move move(squareOf(0, 6), squareOf(2, 5));
+    table.store(42, move, 10, 0, 4, ExactBound);
+    table.store(42, Move{}, 20, 0, 6, UpperBound);
+    TTEntry entry{};
+    ASSERT_TRUE(table.probe(42, entry));
+    EXPECT_EQ(entry.move, move);
+    EXPECT_EQ(entry.score, 20);
+}
+
+TEST(TranspositionTableTest, DepthPreferredKeepsDeeperEntries) {
+    // A tiny table: every key lands in the single bucket.
+    TranspositionTable table(0, ReplacementPolicy::DepthPreferred);
+    for (uint64_t key = 1; key <= TranspositionTable::BucketSize; ++key) {
+        table.store(key, Move{}, 0, 0, 10, ExactBound);
+    }
+    table.store(100, Move{}, 0, 0, 3, ExactBound);
+    TTEntry entry{};
+    EXPECT_FALSE(table.probe(100, entry));
+
+    table.setPolicy(ReplacementPolicy::AlwaysReplace);
+    table.store(100, Move{}, 0, 0, 3, ExactBound);
+    EXPECT_TRUE(table.probe(100, entry));
+}
+
+TEST(TranspositionTableTest, AgingEvictsOldSearches) {
+    TranspositionTable table(0, ReplacementPolicy::Aging);
+    for (uint64_t key = 1; key <= TranspositionTable::BucketSize; ++key) {
+        table.store(key, Move{}, 0, 0, key == 1 ? 12 : 20, ExactBound);
+    }
+    table.newSearch();
+    table.newSearch();
+    table.store(100, Move{}, 0, 0, 1, ExactBound);
+    TTEntry entry{};
+    EXPECT_TRUE(table.probe(100, entry));
+    EXPECT_FALSE(table.probe(1, entry));
+}
+
+TEST(TranspositionTableTest, ConcurrentAccessNeverReturnsForeignData) {
+    TranspositionTable table(1, ReplacementPolicy::AlwaysReplace);
+    std::vector<std::thread> threads;
+    std::atomic<int> corrupt{0};
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            uint64_t key = 0x9E3779B97F4A7C15ULL * (t + 1);
+            for (int i = 0; i < 200000; ++i) {
+                key = key * 6364136223846793005ULL + 1442695040888963407ULL;
+                // The stored score is derived from the key, so any mix-up is detectable.
+                table.store(key, Move{}, static_cast<int16_t>(key >> 48), 0, i & 31, ExactBound);
+                TTEntry entry{};
+                if (table.probe(key, entry) && entry.score != static_cast<int16_t>(key >> 48)) corrupt++;
+            }
+        });
+    }
+    for (std::thread &thread : threads) thread.join();
+    EXPECT_EQ(corrupt.load(), 0);
+    EXPECT_GT(table.hashfull(), 0);
+}
@@ -0,0 +1,99 @@
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "include/Board.h"
+#include "include/TranspositionTable.h"
+
+namespace {
+    struct Result {
+        uint64_t probes = 0;
+        uint64_t hits = 0;
+    };
+
+    // Random playouts from the start position; every node is probed and, on a miss, stored.
+    // Revisited openings give hits, deep random tails give pressure on the replacement policy.
+    Result worker(TranspositionTable &table, uint64_t seed, uint64_t operations) {
+        Result result;
+        Board board;
+        uint64_t state = seed;
+        auto next = [&state] {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return state;
+        };
+
+        while (result.probes < operations) {
+            board = Board();
+            board.initialize();
+            for (int ply = 0; ply < 60 && result.probes < operations; ++ply) {
+                MoveList moves;
+                board.generateLegalMoves(moves);
+                if (moves.empty()) break;
+
+                TTEntry entry{};
+                ++result.probes;
+                if (table.probe(board.hash(), entry)) {
+                    ++result.hits;
+                } else {
+                    int depth = static_cast<int>(next() % 16);
+                    table.store(board.hash(), moves[0], 0, 0, depth, ExactBound);
+                }
+                board.makeMove(moves[static_cast<int>(next() % moves.size())]);
+            }
+            if (next() % 64 == 0) table.newSearch();
+        }
+        return result;
+    }
+
+    const char *policyName(ReplacementPolicy policy) {
+        switch (policy) {
+            case ReplacementPolicy::DepthPreferred: return "depth-preferred";
+            case ReplacementPolicy::AlwaysReplace: return "always-replace";
+            default: return "aging";
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    size_t megabytes = 16;
+    uint64_t operations = 2000000;
+    unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!std::strcmp(argv[i], "--hash")) megabytes = std::stoul(argv[i + 1]);
+        else if (!std::strcmp(argv[i], "--ops")) operations = std::stoull(argv[i + 1]);
+        else if (!std::strcmp(argv[i], "--threads")) maxThreads = std::stoul(argv[i + 1]);
+    }
+
+    std::cout << "policy           threads   Mprobes/s   hit rate\n";
+    for (ReplacementPolicy policy : {ReplacementPolicy::DepthPreferred, ReplacementPolicy::AlwaysReplace, ReplacementPolicy::Aging}) {
+        for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+            TranspositionTable table(megabytes, policy);
+            std::vector<Result> results(threads);
+            std::vector<std::thread> pool;
+
+            auto start = std::chrono::steady_clock::now();
+            for (unsigned t = 0; t < threads; ++t) {
+                pool.emplace_back([&, t] { results[t] = worker(table, 0x9E3779B97F4A7C15ULL * (t + 1), operations); });
+            }
+            for (std::thread &thread : pool) thread.join();
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            Result total;
+            for (const Result &r : results) {
+                total.probes += r.probes;
+                total.hits += r.hits;
+            }
+            std::cout << std::left << std::setw(17) << policyName(policy) << std::right
+                      << std::setw(7) << threads
+                      << std::setw(12) << std::fixed << std::setprecision(2) << total.probes / seconds / 1e6
+                      << std::setw(10) << std::setprecision(1) << 100.0 * total.hits / total.probes << "%\n";
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,230 @@
+#include <algorithm>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "include/ParallelSearch.h"
+
+namespace {
+    constexpr size_t DefaultHashMb = 16;
+    constexpr size_t MaxHashMb = 65536;
+    constexpr int MaxThreads = 256;
+    // Moves assumed left on the clock when the GUI sends no movestogo.
+    constexpr int DefaultMovesToGo = 30;
+    // Kept back from the remaining time for GUI and pipe latency.
+    constexpr int64_t MoveOverheadMs = 30;
+
+    // The main thread only reads commands; searches run on the ParallelSearch workers and a
+    // reporter thread waits for each one to print its bestmove, so stop is acted on at once.
+    class UciEngine {
+    public:
+        UciEngine() : table(DefaultHashMb), search(table, 1) {
+            board.fromFEN(StartFEN);
+            search.onIteration([this](const SearchInfo &info) { reportIteration(info); });
+        }
+
+        ~UciEngine() {
+            finishSearch();
+        }
+
+        // False once the GUI has sent quit.
+        bool handle(const std::string &line) {
+            std::istringstream in(line);
+            std::string command;
+            in >> command;
+            if (command == "uci") {
+                send("id name chessgamecpp\n"
+                     "id author chessgamecpp contributors\n"
+                     "option name Hash type spin default " + std::to_string(DefaultHashMb) + " min 1 max " + std::to_string(MaxHashMb) + "\n"
+                     "option name Threads type spin default 1 min 1 max " + std::to_string(MaxThreads) + "\n"
+                     "uciok");
+            } else if (command == "isready") {
+                send("readyok");
+            } else if (command == "ucinewgame") {
+                finishSearch();
+                table.clear();
+            } else if (command == "position") {
+                finishSearch();
+                setPosition(in);
+            } else if (command == "go") {
+                finishSearch();
+                go(in);
+            } else if (command == "stop") {
+                requestStop();
+            } else if (command == "setoption") {
+                finishSearch();
+                setOption(in);
+            } else if (command == "quit") {
+                return false;
+            }
+            return true;
+        }
+
+    private:
+        void send(const std::string &text) {
+            std::lock_guard lock(output);
+            std::cout << text << std::endl;
+        }
+
+        // Only the moves beyond the previous position command are played when the GUI resends
+        // the same game, which is the usual case.
+        void setPosition(std::istringstream &in) {
+            std::string token;
+            std::string fen;
+            in >> token;
+            if (token == "startpos") {
+                fen = StartFEN;
+                token.clear();
+                in >> token;
+            } else if (token == "fen") {
+                while (in >> token && token != "moves") fen += (fen.empty() ? "" : " ") + token;
+            } else {
+                return;
+            }
+            std::vector<std::string> moves;
+            if (token == "moves") {
+                while (in >> token) moves.push_back(token);
+            }
+
+            bool extends = fen == baseFen && moves.size() >= played.size() && std::equal(played.begin(), played.end(), moves.begin());
+            if (!extends) {
+                Board fresh;
+                if (!fresh.fromFEN(fen)) {
+                    send("info string invalid fen " + fen);
+                    return;
+                }
+                board = fresh;
+                baseFen = fen;
+                played.clear();
+                history.clear();
+            }
+            for (size_t i = played.size(); i < moves.size(); ++i) {
+                if (!playMove(moves[i])) {
+                    send("info string illegal move " + moves[i]);
+                    break;
+                }
+            }
+        }
+
+        bool playMove(const std::string &text) {
+            MoveList moves;
+            board.generateLegalMoves(moves);
+            for (Move move : moves) {
+                char uci[6];
+                toUci(move, uci);
+                if (text != uci) continue;
+                history.push_back(board.hash());
+                board.makeMove(move);
+                played.push_back(text);
+                return true;
+            }
+            return false;
+        }
+
+        void go(std::istringstream &in) {
+            SearchLimits limits;
+            int64_t time[2] = {0, 0};
+            int64_t increment[2] = {0, 0};
+            int movesToGo = 0;
+            bool infinite = false;
+            std::string token;
+            while (in >> token) {
+                if (token == "depth") in >> limits.depth;
+                else if (token == "movetime") in >> limits.movetimeMs;
+                else if (token == "nodes") in >> limits.nodes;
+                else if (token == "wtime") in >> time[White];
+                else if (token == "btime") in >> time[Black];
+                else if (token == "winc") in >> increment[White];
+                else if (token == "binc") in >> increment[Black];
+                else if (token == "movestogo") in >> movesToGo;
+                else if (token == "infinite") infinite = true;
+            }
+            limits.depth = std::clamp(limits.depth, 1, MaxPly - 1);
+
+            Color us = board.sideToMove();
+            if (!infinite && !limits.movetimeMs && time[us] > 0) {
+                int64_t budget = time[us] / (movesToGo > 0 ? movesToGo : DefaultMovesToGo) + increment[us] * 3 / 4;
+                limits.movetimeMs = std::max<int64_t>(1, std::min(budget, time[us] - MoveOverheadMs));
+            }
+
+            {
+                std::lock_guard lock(state);
+                stopRequested = false;
+            }
+            search.start(board, limits, history);
+            reporter = std::thread([this, infinite] {
+                SearchResult result = search.wait();
+                // An infinite search may only answer once the GUI has said stop.
+                if (infinite) {
+                    std::unique_lock lock(state);
+                    stopped.wait(lock, [this] { return stopRequested; });
+                }
+                char uci[6] = "0000";
+                if (result.bestMove != Move{}) toUci(result.bestMove, uci);
+                send(std::string("bestmove ") + uci);
+            });
+        }
+
+        void setOption(std::istringstream &in) {
+            std::string token;
+            std::string name;
+            in >> token;
+            while (in >> token && token != "value") name += (name.empty() ? "" : " ") + token;
+            int64_t value = 0;
+            in >> value;
+            if (value <= 0) return;
+            if (name == "Hash") table.resize(std::min<size_t>(value, MaxHashMb));
+            else if (name == "Threads") search.setThreads(static_cast<int>(std::min<int64_t>(value, MaxThreads)));
+        }
+
+        void requestStop() {
+            {
+                std::lock_guard lock(state);
+                stopRequested = true;
+            }
+            stopped.notify_all();
+            search.stop();
+        }
+
+        void finishSearch() {
+            requestStop();
+            if (reporter.joinable()) reporter.join();
+        }
+
+        void reportIteration(const SearchInfo &info) {
+            std::ostringstream out;
+            out << "info depth " << info.depth << " score ";
+            if (info.score >= MateInMaxPly) out << "mate " << (MateScore - info.score + 1) / 2;
+            else if (info.score <= -MateInMaxPly) out << "mate " << -(MateScore + info.score) / 2;
+            else out << "cp " << info.score;
+            out << " nodes " << info.nodes << " nps " << info.nps << " time " << info.timeMs << " pv";
+            for (int i = 0; i < info.pv.length; ++i) {
+                char uci[6];
+                toUci(info.pv.moves[i], uci);
+                out << ' ' << uci;
+            }
+            send(out.str());
+        }
+
+        std::mutex output;
+        std::mutex state;
+        std::condition_variable stopped;
+        bool stopRequested = false;
+        TranspositionTable table;
+        ParallelSearch search;
+        std::thread reporter;
+        Board board;
+        std::string baseFen{StartFEN};
+        std::vector<std::string> played;
+        std::vector<uint64_t> history;
+    };
+}
+
+int main() {
+    UciEngine engine;
+    for (std::string line; std::getline(std::cin, line) && engine.handle(line);) {}
+    return 0;
+}
@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "include/MappedFile.h"
+#include "include/Pgn.h"
+
+namespace {
+    // Chunks are cut at fixed byte offsets and snapped forward to the next game start, so no
+    // pass over the file is needed before the workers start. Small enough to balance the load,
+    // large enough that snapping and scheduling cost nothing.
+    constexpr size_t ChunkSize = 4 << 20;
+
+    struct Failure {
+        size_t game;   // index within the chunk until the chunks are stitched together
+        size_t offset;
+        int ply;
+        std::string token;
+    };
+
+    struct Chunk {
+        size_t begin;
+        size_t end;
+        size_t games = 0;
+        uint64_t moves = 0;
+        std::vector<Failure> failures;
+    };
+
+    void validateChunk(std::string_view text, Chunk &chunk) {
+        PgnReader reader(text.substr(chunk.begin, chunk.end - chunk.begin));
+        PgnGame game;
+        Board board;
+        while (reader.next(game)) {
+            int plies = 0;
+            std::string_view token;
+            if (!replayGame(game, board, plies, &token)) {
+                size_t offset = static_cast<size_t>(game.movetext.data() - text.data());
+                chunk.failures.push_back({chunk.games, offset, plies + 1, std::string(token)});
+            }
+            chunk.moves += plies;
+            ++chunk.games;
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    const char *path = nullptr;
+    int threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--threads") && i + 1 < argc) threads = std::max(1, std::stoi(argv[++i]));
+        else path = argv[i];
+    }
+    if (!path) {
+        std::cout << "usage: chess_validate <file.pgn> [--threads N]\n";
+        return 2;
+    }
+
+    MappedFile file;
+    if (!file.open(path)) {
+        std::cerr << "cannot map " << path << "\n";
+        return 2;
+    }
+    std::string_view text = file.view();
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<Chunk> chunks;
+    for (size_t begin = findGameStart(text, 0); begin < text.size();) {
+        size_t end = begin + ChunkSize < text.size() ? findGameStart(text, begin + ChunkSize) : text.size();
+        chunks.push_back(Chunk{begin, end, 0, 0, {}});
+        begin = end;
+    }
+    // Snapping faulted in pages around every boundary; let the workers bring back only what they read.
+    file.release(0, text.size());
+
+    std::atomic<size_t> nextChunk{0};
+    auto worker = [&] {
+        for (size_t i; (i = nextChunk.fetch_add(1, std::memory_order_relaxed)) < chunks.size();) {
+            validateChunk(text, chunks[i]);
+            // Failures keep copies of their tokens, so the chunk's pages are no longer needed.
+            file.release(chunks[i].begin, chunks[i].end);
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int i = 1; i < threads; ++i) pool.emplace_back(worker);
+    worker();
+    for (std::thread &thread : pool) thread.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    size_t games = 0;
+    size_t failed = 0;
+    uint64_t moves = 0;
+    for (const Chunk &chunk : chunks) {
+        for (const Failure &failure : chunk.failures) {
+            std::cout << "game " << games + failure.game + 1 << " (byte " << failure.offset << ") ply " << failure.ply
+                      << ": " << (failure.token.empty() ? "malformed game" : "illegal move " + failure.token) << "\n";
+        }
+        games += chunk.games;
+        failed += chunk.failures.size();
+        moves += chunk.moves;
+    }
+
+    std::cout << "games " << games << "  invalid " << failed << "  moves " << moves
+              << "  threads " << threads << "  chunks " << chunks.size()
+              << "  time " << std::fixed << std::setprecision(3) << seconds << "s\n"
+              << std::setprecision(0)
+              << "games/s " << (seconds > 0 ? games / seconds : 0)
+              << "  moves/s " << (seconds > 0 ? moves / seconds : 0) << "\n";
+    return failed ? 1 : 0;
+}